@@ -0,0 +1,124 @@
+#include "TraceLoader.h"
+#include "ScopeComparison.h"
+#include "Source/CustomException.h"
+#include "Source/Console/ErrorLog.h"
+#include "Source/Console/Log.h"
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    // The default relative change of the mean, above which a scope counts as a regression
+    constexpr double DEFAULT_THRESHOLD_PERCENT = 5.0;
+    // Changes with a larger p-value are considered noise
+    constexpr double SIGNIFICANCE_LEVEL = 0.01;
+
+    // Returned when a scope has regressed, so that a script can tell a regression apart from an error
+    constexpr int REGRESSION_EXIT_CODE = 2;
+
+    std::string FormatChange(double change)
+    {
+        std::ostringstream stream;
+        stream << std::showpos << std::fixed << std::setprecision(1) << change * 100.0 << "%";
+        return stream.str();
+    }
+}
+
+// Compares the scopes of two saved benchmark traces, which can be either binary traces or JSON
+// files written by TraceConverter. A scope has regressed if its mean got slower by more than
+// the threshold and the change is statistically significant.
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        ERROR_LOG("Usage: BenchmarkComparator <baseline> <candidate> [threshold (%), default: " <<
+                  DEFAULT_THRESHOLD_PERCENT << "]");
+        return 1;
+    }
+
+    try
+    {
+        const double threshold = (argc > 3 ? std::stod(argv[3]) : DEFAULT_THRESHOLD_PERCENT) / 100.0;
+
+        const ScopeSamples baselineSamples = LoadTrace(argv[1]);
+        const ScopeSamples candidateSamples = LoadTrace(argv[2]);
+
+        std::vector<ScopeComparison> comparisons;
+        std::vector<std::string> unmatchedScopes;
+        for (const auto& [name, samples] : baselineSamples)
+        {
+            const auto candidate = candidateSamples.find(name);
+            // The t-test needs a variance for both runs
+            if (candidate == candidateSamples.end() || samples.size() < 2 || candidate->second.size() < 2)
+            {
+                unmatchedScopes.push_back(name);
+                continue;
+            }
+            comparisons.push_back(Compare(name, Summarize(samples), Summarize(candidate->second)));
+        }
+        for (const auto& [name, samples] : candidateSamples)
+        {
+            if (!baselineSamples.contains(name))
+            {
+                unmatchedScopes.push_back(name);
+            }
+        }
+
+        // The largest regressions are listed first
+        std::sort(comparisons.begin(), comparisons.end(), [](const ScopeComparison& a, const ScopeComparison& b)
+            {
+                return a.meanChange > b.meanChange;
+            });
+
+        std::ostringstream table;
+        table << std::fixed << std::setprecision(3);
+        table << std::setw(13) << "Mean (us)" << std::setw(13) << "" << std::setw(9) << "Change" <<
+            std::setw(13) << "p95 (us)" << std::setw(13) << "" << std::setw(9) << "Change" <<
+            std::setw(10) << "p-value" << "  Name\n";
+
+        size_t nRegressions = 0;
+        for (const ScopeComparison& comparison : comparisons)
+        {
+            const bool isSignificant = comparison.pValue < SIGNIFICANCE_LEVEL;
+            const bool isRegression = isSignificant && comparison.meanChange > threshold;
+            nRegressions += isRegression;
+
+            table << std::setw(13) << comparison.baseline.mean << std::setw(13) << comparison.candidate.mean <<
+                std::setw(9) << FormatChange(comparison.meanChange) <<
+                std::setw(13) << comparison.baseline.p95 << std::setw(13) << comparison.candidate.p95 <<
+                std::setw(9) << FormatChange(comparison.p95Change) <<
+                std::setw(10) << std::setprecision(4) << comparison.pValue << std::setprecision(3) <<
+                (isRegression ? " !" : isSignificant ? " *" : "  ") << comparison.name << "\n";
+        }
+        table << "\n! = regression, * = significant change (p < " << SIGNIFICANCE_LEVEL << ")\n";
+
+        if (!unmatchedScopes.empty())
+        {
+            table << "\nNot compared, since the scope is missing or has fewer than two timings in one of the traces:\n";
+            for (const std::string& name : unmatchedScopes)
+            {
+                table << "  " << name << "\n";
+            }
+        }
+        LOG(table.str());
+
+        if (nRegressions > 0)
+        {
+            LOG(nRegressions << " scope(s) regressed by more than " << threshold * 100.0 << "%" << std::endl);
+            return REGRESSION_EXIT_CODE;
+        }
+        LOG("No regressions" << std::endl);
+    }
+    catch (const CustomException& exception)
+    {
+        ERROR_LOG(exception.what());
+        return 1;
+    }
+    catch (const std::exception& exception)
+    {
+        ERROR_LOG(exception.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "ScopeComparison.h"
+#include <cmath>
+
+namespace
+{
+	// The continued fraction of the regularized incomplete beta function, evaluated with the modified Lentz's method
+	double IncompleteBetaFraction(double a, double b, double x)
+	{
+		constexpr int MAX_ITERATIONS = 300;
+		constexpr double EPSILON = 1e-14;
+		constexpr double TINY = 1e-300;
+
+		double c = 1.0;
+		double d = 1.0 - (a + b) * x / (a + 1.0);
+		d = 1.0 / (std::abs(d) < TINY ? TINY : d);
+		double fraction = d;
+
+		for (int m = 1; m <= MAX_ITERATIONS; m++)
+		{
+			// Every iteration adds an even and an odd step of the fraction
+			for (int step = 0; step < 2; step++)
+			{
+				const double numerator = step == 0 ?
+					m * (b - m) * x / ((a + 2.0 * m - 1.0) * (a + 2.0 * m)) :
+					-(a + m) * (a + b + m) * x / ((a + 2.0 * m) * (a + 2.0 * m + 1.0));
+
+				d = 1.0 + numerator * d;
+				d = 1.0 / (std::abs(d) < TINY ? TINY : d);
+				c = 1.0 + numerator / c;
+				c = std::abs(c) < TINY ? TINY : c;
+				fraction *= d * c;
+
+				if (step == 1 && std::abs(d * c - 1.0) < EPSILON)
+				{
+					return fraction;
+				}
+			}
+		}
+		return fraction;
+	}
+
+	// The regularized incomplete beta function I_x(a, b)
+	double IncompleteBeta(double a, double b, double x)
+	{
+		if (x <= 0.0)
+		{
+			return 0.0;
+		}
+		if (x >= 1.0)
+		{
+			return 1.0;
+		}
+
+		const double logFront = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+			a * std::log(x) + b * std::log(1.0 - x);
+		// The continued fraction converges quickly only on one side of the mean of the distribution
+		if (x < (a + 1.0) / (a + b + 2.0))
+		{
+			return std::exp(logFront) * IncompleteBetaFraction(a, b, x) / a;
+		}
+		return 1.0 - std::exp(logFront) * IncompleteBetaFraction(b, a, 1.0 - x) / b;
+	}
+
+	// The probability that the absolute value of a Student's t-distributed variable exceeds |t|
+	double StudentTwoSidedTail(double t, double degreesOfFreedom)
+	{
+		return IncompleteBeta(degreesOfFreedom / 2.0, 0.5, degreesOfFreedom / (degreesOfFreedom + t * t));
+	}
+
+	double GetRelativeChange(double baseline, double candidate)
+	{
+		return baseline > 0.0 ? candidate / baseline - 1.0 : 0.0;
+	}
+}
+
+SampleSummary Summarize(std::vector<double> samples)
+{
+	SampleSummary summary;
+	summary.count = samples.size();
+	if (samples.empty())
+	{
+		return summary;
+	}
+
+	// Welford's algorithm, which does not lose precision when the variance is small compared to the mean
+	double mean = 0.0;
+	double squaredDistanceSum = 0.0;
+	for (size_t i = 0; i < samples.size(); i++)
+	{
+		const double delta = samples[i] - mean;
+		mean += delta / (i + 1);
+		squaredDistanceSum += delta * (samples[i] - mean);
+	}
+	summary.mean = mean;
+	summary.variance = samples.size() > 1 ? squaredDistanceSum / (samples.size() - 1) : 0.0;
+
+	// Nearest-rank percentile
+	const size_t p95Index = (size_t)std::ceil(0.95 * samples.size()) - 1;
+	std::nth_element(samples.begin(), samples.begin() + p95Index, samples.end());
+	summary.p95 = samples[p95Index];
+
+	return summary;
+}
+
+ScopeComparison Compare(const std::string& name, const SampleSummary& baseline, const SampleSummary& candidate)
+{
+	assert(baseline.count > 1 && candidate.count > 1);
+
+	ScopeComparison comparison;
+	comparison.name = name;
+	comparison.baseline = baseline;
+	comparison.candidate = candidate;
+	comparison.meanChange = GetRelativeChange(baseline.mean, candidate.mean);
+	comparison.p95Change = GetRelativeChange(baseline.p95, candidate.p95);
+
+	// Welch's t-test, which unlike Student's t-test does not assume that both runs have the same variance
+	const double baselineError = baseline.variance / baseline.count;
+	const double candidateError = candidate.variance / candidate.count;
+	const double standardError = std::sqrt(baselineError + candidateError);
+	if (standardError == 0.0)
+	{
+		// Without any variance, every difference is significant
+		comparison.pValue = baseline.mean == candidate.mean ? 1.0 : 0.0;
+		return comparison;
+	}
+
+	const double t = (candidate.mean - baseline.mean) / standardError;
+	// The Welch–Satterthwaite equation
+	const double degreesOfFreedom = std::pow(baselineError + candidateError, 2.0) /
+		(baselineError * baselineError / (baseline.count - 1) + candidateError * candidateError / (candidate.count - 1));
+	comparison.pValue = StudentTwoSidedTail(t, degreesOfFreedom);
+
+	return comparison;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+struct SampleSummary
+{
+	size_t count = 0;
+	double mean = 0.0;
+	// The unbiased sample variance
+	double variance = 0.0;
+	double p95 = 0.0;
+};
+
+// The difference between the timings of a scope in two traces
+struct ScopeComparison
+{
+	std::string name;
+	SampleSummary baseline;
+	SampleSummary candidate;
+	// Relative changes from the baseline to the candidate, e.g., 0.1 means 10% slower
+	double meanChange = 0.0;
+	double p95Change = 0.0;
+	// The two-sided p-value of Welch's t-test, i.e., the probability of observing a difference
+	// in the means at least this large if the scope's performance did not actually change
+	double pValue = 1.0;
+};
+
+SampleSummary Summarize(std::vector<double> samples);
+// Both summaries need at least two samples
+ScopeComparison Compare(const std::string& name, const SampleSummary& baseline, const SampleSummary& candidate);
@@ -0,0 +1,285 @@
+#include "TraceLoader.h"
+#include "Source/Benchmark/BenchmarkTraceReader.h"
+#include "Source/CustomException.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <cctype>
+
+namespace
+{
+	const std::string FRAME_SCOPE_NAME = "Frame";
+
+	// The top-level fields of an event. Strings are stored without their quotes, and nested values, like "args", are left out.
+	using EventFields = std::unordered_map<std::string, std::string>;
+
+	// A minimal parser for the trace event format, which is all that is needed to read the files written by TraceConverter
+	class EventParser
+	{
+	public:
+		EventParser(std::string text)
+			:
+			mText(std::move(text))
+		{}
+
+		// Calls "onEvent" for every event. Accepts both the array and the object format of the trace event
+		// format, including the missing closing bracket that "chrome://tracing" allows for.
+		void Parse(const std::function<void(const EventFields&)>& onEvent)
+		{
+			SkipWhitespace();
+			if (Peek() != '{')
+			{
+				ParseEvents(onEvent);
+				return;
+			}
+
+			// The object format keeps the events inside "traceEvents"
+			ParseObject([&](const std::string& key)
+				{
+					if (key == "traceEvents")
+					{
+						ParseEvents(onEvent);
+					}
+					else
+					{
+						SkipValue();
+					}
+				});
+		}
+	private:
+		void ParseEvents(const std::function<void(const EventFields&)>& onEvent)
+		{
+			Expect('[');
+			while (true)
+			{
+				// The closing bracket may be missing at the end of the file, and may follow a trailing comma
+				SkipWhitespace();
+				if (mPosition == mText.size())
+				{
+					return;
+				}
+				if (Peek() == ']')
+				{
+					mPosition++;
+					return;
+				}
+
+				EventFields fields;
+				ParseObject([&](const std::string& key)
+					{
+						const char c = Peek();
+						if (c == '{' || c == '[')
+						{
+							SkipValue();
+						}
+						else
+						{
+							fields[key] = c == '"' ? ParseString() : ParseScalar();
+						}
+					});
+				onEvent(fields);
+
+				SkipWhitespace();
+				if (mPosition == mText.size())
+				{
+					return;
+				}
+				if (Peek() != ']')
+				{
+					Expect(',');
+				}
+			}
+		}
+		// Calls "onMember" with the position at the start of the member's value, which "onMember" has to consume
+		void ParseObject(const std::function<void(const std::string& key)>& onMember)
+		{
+			Expect('{');
+			SkipWhitespace();
+			if (Peek() == '}')
+			{
+				mPosition++;
+				return;
+			}
+
+			while (true)
+			{
+				SkipWhitespace();
+				const std::string key = ParseString();
+				SkipWhitespace();
+				Expect(':');
+				SkipWhitespace();
+				onMember(key);
+				SkipWhitespace();
+
+				if (Peek() == '}')
+				{
+					mPosition++;
+					return;
+				}
+				Expect(',');
+			}
+		}
+		std::string ParseString()
+		{
+			Expect('"');
+			std::string string;
+			while (Peek() != '"')
+			{
+				char c = Next();
+				if (c == '\\')
+				{
+					c = Next();
+					switch (c)
+					{
+					case 'n': c = '\n'; break;
+					case 't': c = '\t'; break;
+					case 'r': c = '\r'; break;
+					case 'b': c = '\b'; break;
+					case 'f': c = '\f'; break;
+					// Scope names are ASCII, so the code point does not have to be decoded
+					case 'u': mPosition += 4; c = '?'; break;
+					}
+				}
+				string += c;
+			}
+			mPosition++;
+			return string;
+		}
+		// Numbers, "true", "false" and "null"
+		std::string ParseScalar()
+		{
+			const size_t start = mPosition;
+			while (mPosition < mText.size() && !std::isspace((unsigned char)mText[mPosition]) &&
+				   mText[mPosition] != ',' && mText[mPosition] != '}' && mText[mPosition] != ']')
+			{
+				mPosition++;
+			}
+			if (start == mPosition)
+			{
+				throw CreateParseError("Expected a value");
+			}
+			return mText.substr(start, mPosition - start);
+		}
+		void SkipValue()
+		{
+			switch (Peek())
+			{
+			case '"':
+				ParseString();
+				break;
+			case '{':
+				ParseObject([this](const std::string&) { SkipValue(); });
+				break;
+			case '[':
+				mPosition++;
+				SkipWhitespace();
+				while (Peek() != ']')
+				{
+					SkipValue();
+					SkipWhitespace();
+					if (Peek() == ',')
+					{
+						mPosition++;
+						SkipWhitespace();
+					}
+				}
+				mPosition++;
+				break;
+			default:
+				ParseScalar();
+			}
+		}
+
+		void SkipWhitespace()
+		{
+			while (mPosition < mText.size() && std::isspace((unsigned char)mText[mPosition]))
+			{
+				mPosition++;
+			}
+		}
+		void Expect(char expected)
+		{
+			if (Next() != expected)
+			{
+				throw CreateParseError(std::string("Expected '") + expected + "'");
+			}
+		}
+		// Returns '\0' at the end of the text
+		char Peek() const
+		{
+			return mPosition < mText.size() ? mText[mPosition] : '\0';
+		}
+		char Next()
+		{
+			if (mPosition >= mText.size())
+			{
+				throw CreateParseError("Unexpected end of file");
+			}
+			return mText[mPosition++];
+		}
+		CustomException CreateParseError(const std::string& message) const
+		{
+			return CREATE_CUSTOM_EXCEPTION(message + " at offset " + std::to_string(mPosition));
+		}
+	private:
+		std::string mText;
+		size_t mPosition = 0;
+	};
+
+	ScopeSamples LoadJsonTrace(const std::string& filePath)
+	{
+		std::ifstream file(filePath, std::ios::binary);
+		if (!file.good())
+		{
+			throw CREATE_CUSTOM_EXCEPTION("Failed to open: " + filePath);
+		}
+		std::stringstream text;
+		text << file.rdbuf();
+
+		ScopeSamples samples;
+		EventParser(text.str()).Parse([&samples](const EventFields& fields)
+			{
+				// Only complete events have a duration
+				const auto phase = fields.find("ph");
+				const auto name = fields.find("name");
+				const auto duration = fields.find("dur");
+				if (phase == fields.end() || phase->second != "X" || name == fields.end() || duration == fields.end())
+				{
+					return;
+				}
+
+				// Every frame has its own name, e.g., "Frame 42"
+				const auto category = fields.find("cat");
+				const bool isFrame = category != fields.end() && category->second == "Frame";
+				samples[isFrame ? FRAME_SCOPE_NAME : name->second].push_back(std::stod(duration->second));
+			});
+		return samples;
+	}
+
+	ScopeSamples LoadBinaryTrace(const std::string& filePath)
+	{
+		ScopeSamples samples;
+
+		benchmark::TraceReader::Handlers handlers;
+		handlers.onTiming = [&samples](const benchmark::data::Timing& data, const std::string& scopeName, unsigned int)
+		{
+			samples[scopeName].push_back(data.duration / 1000.0);
+		};
+		handlers.onFrame = [&samples](const benchmark::data::Frame& data, unsigned int)
+		{
+			samples[FRAME_SCOPE_NAME].push_back(data.duration / 1000.0);
+		};
+
+		benchmark::TraceReader(filePath).Read(handlers);
+		return samples;
+	}
+}
+
+ScopeSamples LoadTrace(const std::string& filePath)
+{
+	if (std::filesystem::path(filePath).extension() == ".json")
+	{
+		return LoadJsonTrace(filePath);
+	}
+	return LoadBinaryTrace(filePath);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+// The durations of every scope inside a trace in microseconds, keyed by the name of the scope.
+// The durations of all frames are collected under "Frame".
+using ScopeSamples = std::unordered_map<std::string, std::vector<double>>;
+
+// Loads a binary trace written by "benchmark::Manager", or a JSON file written by TraceConverter.
+// The format is chosen by the extension of the file. Throws a "CustomException" on failure.
+ScopeSamples LoadTrace(const std::string& filePath);
@@ -0,0 +1,341 @@
+#include "Source/Noise/PerlinNoise.h"
+#include "Source/Noise/SimplexNoise.h"
+#include "Source/Noise/ValueNoise.h"
+#include "Source/Noise/WorleyNoise.h"
+#include "Source/Noise/FbmNoise.h"
+#include "Source/Noise/NoiseTableRegistry.h"
+#include "Source/Noise/NoiseGrid.h"
+#include "Source/Threading/ThreadPool.h"
+#include "Source/Benchmark/BenchmarkMacros.h"
+#include "Source/CustomConcepts.h"
+#include "Source/CustomException.h"
+#include "Source/Console/ErrorLog.h"
+#include "Source/Console/Log.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    constexpr size_t SAMPLE_COUNT = 1 << 16;
+    // The runs before the measured ones, which warm up the caches, the branch predictors and the thread pool
+    constexpr int WARMUP_COUNT = 3;
+    // Every measurement is repeated and the median is reported, which filters out
+    // the runs that got interrupted by the OS
+    constexpr int REPETITION_COUNT = 15;
+    // The number of samples per iteration of the multi-threaded runs. Large enough for an iteration
+    // to outweigh handing it out, small enough for the iterations to get balanced between the threads.
+    constexpr size_t SAMPLES_PER_TASK = 4096;
+    // The positions span several periods of the lattice, so that the hashes cover every table entry
+    constexpr float POSITION_RANGE = 1024.0f;
+    // The octaves of the fractal noise, which evaluates its noise once per octave
+    constexpr int FBM_OCTAVE_COUNT = 4;
+
+    struct Measurement
+    {
+        double nanosecondsPerSample = 0.0;
+        // The standard deviation of the repetitions, relative to their mean
+        double deviationPercent = 0.0;
+    };
+
+    template<int N>
+    noise::Positions<N> CreatePositions(std::array<std::vector<float>, N>& coordinates)
+    {
+        noise::SplitMix64 randomNumberGenerator(noise::DEFAULT_SEED);
+        noise::Positions<N> positions;
+        for (int i = 0; i < N; ++i)
+        {
+            coordinates[i].resize(SAMPLE_COUNT);
+            for (float& coordinate : coordinates[i])
+            {
+                coordinate = (randomNumberGenerator.NextFloat() * 2.0f - 1.0f) * POSITION_RANGE;
+            }
+            positions[i] = coordinates[i];
+        }
+        return positions;
+    }
+
+    // "function" processes all of the "sampleCount" samples once. Every repetition is also recorded as a
+    // timing of the scope "scopeName", so that two builds can be compared with BenchmarkComparator.
+    template<class FunctionT>
+    Measurement Measure(const std::string& scopeName, FunctionT&& function, const size_t sampleCount = SAMPLE_COUNT)
+    {
+        for (int i = 0; i < WARMUP_COUNT; ++i)
+        {
+            function();
+        }
+
+#if ENABLE_BENCHMARKING
+        const benchmark::ScopeDescriptor scope(scopeName.c_str());
+#endif
+        std::vector<double> nanoseconds(REPETITION_COUNT);
+        for (double& time : nanoseconds)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            {
+#if ENABLE_BENCHMARKING
+                benchmark::Timer timer(scope);
+#endif
+                function();
+            }
+            time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        double mean = 0.0;
+        for (const double time : nanoseconds)
+        {
+            mean += time / REPETITION_COUNT;
+        }
+        double variance = 0.0;
+        for (const double time : nanoseconds)
+        {
+            variance += (time - mean) * (time - mean) / (REPETITION_COUNT - 1);
+        }
+
+        std::nth_element(nanoseconds.begin(), nanoseconds.begin() + REPETITION_COUNT / 2, nanoseconds.end());
+        return Measurement{ nanoseconds[REPETITION_COUNT / 2] / (double)sampleCount, std::sqrt(variance) / mean * 100.0 };
+    }
+
+    void AddRow(std::ostringstream& table, const std::string& name, const std::string& hashName, const std::string& tableSize,
+                const std::string& mode, const unsigned int threadCount, const Measurement& measurement)
+    {
+        table << std::setw(16) << name << std::setw(13) << hashName << std::setw(7) << tableSize <<
+            std::setw(7) << mode << std::setw(9) << threadCount << std::setw(12) << measurement.nanosecondsPerSample <<
+            std::setw(14) << 1000.0 / measurement.nanosecondsPerSample << std::setw(9) << measurement.deviationPercent << "\n";
+    }
+
+    // Measures "Get" and "GetMany" of "noise", both on the calling thread and spread over the shared thread pool
+    template<class NoiseT>
+    void MeasureNoise(const std::string& name, const std::string& hashName, const int tableSize, const NoiseT& noise,
+                      std::ostringstream& table)
+    {
+        constexpr int N = NoiseT::DIMENSION;
+        std::array<std::vector<float>, N> coordinates;
+        const noise::Positions<N> positions = CreatePositions<N>(coordinates);
+        std::vector<float> out(SAMPLE_COUNT);
+
+        // Both evaluate the samples in [begin, end)
+        auto get = [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                BasicVector<float, N> position;
+                for (int j = 0; j < N; ++j)
+                {
+                    position[j] = coordinates[j][i];
+                }
+                out[i] = noise.Get(position);
+            }
+        };
+        auto getMany = [&](size_t begin, size_t end)
+        {
+            noise::Positions<N> range;
+            for (int j = 0; j < N; ++j)
+            {
+                range[j] = positions[j].subspan(begin, end - begin);
+            }
+            noise.GetMany(range, std::span<float>(out).subspan(begin, end - begin));
+        };
+
+        ThreadPool& threadPool = ThreadPool::GetShared();
+        auto measureMode = [&](const std::string& mode, const auto& evaluateRange)
+        {
+            const std::string scopeName = name + " " + hashName + " " + std::to_string(tableSize) + " " + mode;
+
+            const Measurement singleThreaded = Measure(scopeName, [&]()
+                {
+                    evaluateRange(0, SAMPLE_COUNT);
+                });
+            AddRow(table, name, hashName, std::to_string(tableSize), mode, 1, singleThreaded);
+
+            // The pool would only run the iterations on the calling thread
+            if (threadPool.GetThreadCount() == 1)
+            {
+                return;
+            }
+            const Measurement multiThreaded = Measure(scopeName + " x" + std::to_string(threadPool.GetThreadCount()), [&]()
+                {
+                    threadPool.ParallelFor(SAMPLE_COUNT / SAMPLES_PER_TASK, [&](size_t task)
+                        {
+                            evaluateRange(task * SAMPLES_PER_TASK, (task + 1) * SAMPLES_PER_TASK);
+                        });
+                });
+            AddRow(table, name, hashName, std::to_string(tableSize), mode, threadPool.GetThreadCount(), multiThreaded);
+        };
+        measureMode("Get", get);
+        measureMode("Batch", getMany);
+    }
+
+    // Fractal Brownian motion over "NoiseT", with "FBM_OCTAVE_COUNT" octaves
+    template<class NoiseT>
+    FbmNoise<NoiseT> CreateFbmNoise(const NoiseT& noise)
+    {
+        FbmSettings settings;
+        settings.octaveCount = FBM_OCTAVE_COUNT;
+        return FbmNoise<NoiseT>(std::make_shared<const NoiseT>(noise), settings);
+    }
+
+    // Uses the permutation hash with tables of "N_RANDOM_VALUES" entries, which shows how the
+    // noise slows down once the tables no longer fit into the caches
+    template<int N_RANDOM_VALUES>
+    void MeasureTableSize(std::ostringstream& table)
+    {
+        using PermutationHash = noise::PermutationHash<N_RANDOM_VALUES>;
+        const auto permutationTable = NoiseTableRegistry::GetPermutationTable<N_RANDOM_VALUES>();
+        const auto randomValues = NoiseTableRegistry::GetRandomValueTable<N_RANDOM_VALUES>();
+
+        MeasureNoise("PerlinNoise<2>", "Permutation", N_RANDOM_VALUES, PerlinNoise<2, N_RANDOM_VALUES, 3, PermutationHash>(permutationTable), table);
+        MeasureNoise("PerlinNoise<3>", "Permutation", N_RANDOM_VALUES, PerlinNoise<3, N_RANDOM_VALUES, 3, PermutationHash>(permutationTable), table);
+        MeasureNoise("PerlinNoise<4>", "Permutation", N_RANDOM_VALUES, PerlinNoise<4, N_RANDOM_VALUES, 4, PermutationHash>(permutationTable), table);
+        MeasureNoise("SimplexNoise<2>", "Permutation", N_RANDOM_VALUES, SimplexNoise<2, N_RANDOM_VALUES, 3, PermutationHash>(permutationTable), table);
+        MeasureNoise("SimplexNoise<3>", "Permutation", N_RANDOM_VALUES, SimplexNoise<3, N_RANDOM_VALUES, 3, PermutationHash>(permutationTable), table);
+        MeasureNoise("SimplexNoise<4>", "Permutation", N_RANDOM_VALUES, SimplexNoise<4, N_RANDOM_VALUES, 4, PermutationHash>(permutationTable), table);
+        MeasureNoise("Fbm<Perlin<3>>", "Permutation", N_RANDOM_VALUES, CreateFbmNoise(PerlinNoise<3, N_RANDOM_VALUES, 3, PermutationHash>(permutationTable)), table);
+        MeasureNoise("ValueNoise<2>", "Permutation", N_RANDOM_VALUES, ValueNoise<2, N_RANDOM_VALUES, PermutationHash>(randomValues, permutationTable), table);
+        MeasureNoise("ValueNoise<3>", "Permutation", N_RANDOM_VALUES, ValueNoise<3, N_RANDOM_VALUES, PermutationHash>(randomValues, permutationTable), table);
+        MeasureNoise("ValueNoise<4>", "Permutation", N_RANDOM_VALUES, ValueNoise<4, N_RANDOM_VALUES, PermutationHash>(randomValues, permutationTable), table);
+        MeasureNoise("WorleyNoise<2>", "Permutation", N_RANDOM_VALUES, WorleyNoise<2, N_RANDOM_VALUES, PermutationHash>(permutationTable), table);
+        MeasureNoise("WorleyNoise<3>", "Permutation", N_RANDOM_VALUES, WorleyNoise<3, N_RANDOM_VALUES, PermutationHash>(permutationTable), table);
+    }
+    // The integer hash needs no permutation table, so it is only measured with a single table size
+    void MeasureIntegerHash(std::ostringstream& table)
+    {
+        using IntegerHash = noise::IntegerHash<256>;
+        const auto randomValues = NoiseTableRegistry::GetRandomValueTable<256>();
+
+        MeasureNoise("PerlinNoise<2>", "Integer", 256, PerlinNoise<2, 256, 3, IntegerHash>(IntegerHash()), table);
+        MeasureNoise("PerlinNoise<3>", "Integer", 256, PerlinNoise<3, 256, 3, IntegerHash>(IntegerHash()), table);
+        MeasureNoise("PerlinNoise<4>", "Integer", 256, PerlinNoise<4, 256, 4, IntegerHash>(IntegerHash()), table);
+        MeasureNoise("SimplexNoise<2>", "Integer", 256, SimplexNoise<2, 256, 3, IntegerHash>(IntegerHash()), table);
+        MeasureNoise("SimplexNoise<3>", "Integer", 256, SimplexNoise<3, 256, 3, IntegerHash>(IntegerHash()), table);
+        MeasureNoise("SimplexNoise<4>", "Integer", 256, SimplexNoise<4, 256, 4, IntegerHash>(IntegerHash()), table);
+        MeasureNoise("Fbm<Perlin<3>>", "Integer", 256, CreateFbmNoise(PerlinNoise<3, 256, 3, IntegerHash>(IntegerHash())), table);
+        MeasureNoise("ValueNoise<2>", "Integer", 256, ValueNoise<2, 256, IntegerHash>(randomValues, IntegerHash()), table);
+        MeasureNoise("ValueNoise<3>", "Integer", 256, ValueNoise<3, 256, IntegerHash>(randomValues, IntegerHash()), table);
+        MeasureNoise("ValueNoise<4>", "Integer", 256, ValueNoise<4, 256, IntegerHash>(randomValues, IntegerHash()), table);
+        MeasureNoise("WorleyNoise<2>", "Integer", 256, WorleyNoise<2, 256, IntegerHash>(IntegerHash()), table);
+        MeasureNoise("WorleyNoise<3>", "Integer", 256, WorleyNoise<3, 256, IntegerHash>(IntegerHash()), table);
+    }
+
+    // Fills a grid with "noise::NoiseGrid" on pools of 1 up to one thread per hardware thread, and reports
+    // how the fill scales with the number of threads
+    void MeasureGrid(std::ostringstream& table)
+    {
+        // 256 tiles, so that there are enough of them to balance between the threads
+        constexpr std::array<int, 3> GRID_SIZE = { 128, 128, 64 };
+        constexpr size_t GRID_SAMPLE_COUNT = (size_t)GRID_SIZE[0] * GRID_SIZE[1] * GRID_SIZE[2];
+        constexpr size_t ROW_STRIDE = GRID_SIZE[0];
+        constexpr size_t SLICE_STRIDE = ROW_STRIDE * GRID_SIZE[1];
+        const noise::NoiseGrid<3> grid(GRID_SIZE, { 0.0f, 0.0f, 0.0f }, { 0.25f, 0.25f, 0.25f });
+        const PerlinNoise<3> perlinNoise(NoiseTableRegistry::GetPermutationTable<256>());
+
+        // The grid needs its buffer to be aligned to cache lines
+        constexpr std::align_val_t ALIGNMENT = std::align_val_t(noise::NoiseGrid<3>::ALIGNMENT);
+        const auto deleter = [](float* values) { ::operator delete(values, ALIGNMENT); };
+        const std::unique_ptr<float[], decltype(deleter)> out((float*)::operator new(GRID_SAMPLE_COUNT * sizeof(float), ALIGNMENT), deleter);
+
+        const unsigned int maxThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        std::vector<double> nanosecondsPerSample;
+        for (unsigned int threadCount = 1; threadCount <= maxThreadCount; ++threadCount)
+        {
+            ThreadPool threadPool(threadCount);
+            const Measurement measurement = Measure("PerlinNoise<3> grid x" + std::to_string(threadCount), [&]()
+                {
+                    grid.Generate(perlinNoise, std::span<float>(out.get(), GRID_SAMPLE_COUNT), ROW_STRIDE, SLICE_STRIDE, threadPool);
+                }, GRID_SAMPLE_COUNT);
+            AddRow(table, "PerlinNoise<3>", "Permutation", "256", "Grid", threadCount, measurement);
+            nanosecondsPerSample.push_back(measurement.nanosecondsPerSample);
+        }
+
+        table << "Speedup of the grid over 1 thread:";
+        for (size_t i = 0; i < nanosecondsPerSample.size(); ++i)
+        {
+            table << (i == 0 ? " " : ", ") << i + 1 << " threads " << nanosecondsPerSample[0] / nanosecondsPerSample[i] << "x";
+        }
+        table << "\n";
+    }
+
+    // The helpers are constexpr, but they also get called at runtime, e.g., by the asserts of the noise
+    void MeasureHelpers(std::ostringstream& table)
+    {
+        noise::SplitMix64 randomNumberGenerator(noise::DEFAULT_SEED);
+        std::vector<int> values(SAMPLE_COUNT);
+        std::vector<int> exponents(SAMPLE_COUNT);
+        for (size_t i = 0; i < SAMPLE_COUNT; ++i)
+        {
+            exponents[i] = (int)randomNumberGenerator.NextBelow(20);
+            // Every other value is a power of two, so that both outcomes get measured
+            values[i] = i % 2 == 0 ? 1 << exponents[i] : (int)randomNumberGenerator.NextBelow(1 << 20) + 1;
+        }
+        // Keeps the compiler from removing the calls
+        volatile int sink = 0;
+
+        const Measurement isPowerOfTwo = Measure("IsPowerOfTwo", [&]()
+            {
+                int count = 0;
+                for (const int value : values)
+                {
+                    count += IsPowerOfTwo(value) ? 1 : 0;
+                }
+                sink = count;
+            });
+        AddRow(table, "IsPowerOfTwo", "-", "-", "Get", 1, isPowerOfTwo);
+
+        const Measurement power = Measure("Power", [&]()
+            {
+                int sum = 0;
+                for (const int exponent : exponents)
+                {
+                    sum += Power(3, exponent);
+                }
+                sink = sum;
+            });
+        AddRow(table, "Power", "-", "-", "Get", 1, power);
+    }
+}
+
+// Sweeps the noise over its dimensions, table sizes and hash policies, and measures single samples
+// against batches, both on one thread and on all of them. Also measures how filling a grid scales
+// from 1 thread up to all of them. Runs without a window or a GPU. Every
+// repetition is also written into the benchmark trace, which BenchmarkComparator can compare
+// against the trace of another build.
+int main()
+{
+    try
+    {
+        // The comparator needs every repetition, not only the aggregated statistics
+        benchmark::Manager::Get().SetMode(benchmark::Mode::Trace);
+        CREATE_BENCHMARK_SESSION("NoiseBenchmark");
+        NAME_THREAD("Main");
+
+        std::ostringstream table;
+        table << std::fixed << std::setprecision(2);
+        table << "Batches use " << simd::GetInstructionSetName(simd::GetInstructionSet()) << ", " << SAMPLE_COUNT <<
+            " samples, the median of " << REPETITION_COUNT << " repetitions, " << FBM_OCTAVE_COUNT << " octaves of fractal noise\n";
+        table << std::setw(16) << "Noise" << std::setw(13) << "Hash" << std::setw(7) << "Table" << std::setw(7) << "Mode" <<
+            std::setw(9) << "Threads" << std::setw(12) << "ns/sample" << std::setw(14) << "Msamples/s" << std::setw(9) << "+-%" << "\n";
+
+        MeasureTableSize<64>(table);
+        MeasureTableSize<256>(table);
+        MeasureTableSize<4096>(table);
+        MeasureIntegerHash(table);
+        MeasureHelpers(table);
+        MeasureGrid(table);
+
+        LOG(table.str());
+    }
+    catch (const CustomException& exception)
+    {
+        ERROR_LOG(exception.what());
+        return 1;
+    }
+    catch (const std::exception& exception)
+    {
+        ERROR_LOG(exception.what());
+        return 1;
+    }
+    return 0;
+}
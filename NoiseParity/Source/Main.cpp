@@ -0,0 +1,481 @@
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include "Source/Rendering/Shader.h"
+#include "Source/Rendering/GlMacro.h"
+#include "Source/Noise/PerlinNoise.h"
+#include "Source/Noise/SimplexNoise.h"
+#include "Source/Noise/WorleyNoise.h"
+#include "Source/Noise/NoiseTableRegistry.h"
+#include "Source/CustomException.h"
+#include "Source/Console/ErrorLog.h"
+#include "Source/Console/Log.h"
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    // The samples form a square texture, i.e., about four million samples per noise
+    constexpr int TEXTURE_SIZE = 2048;
+    constexpr size_t SAMPLE_COUNT = (size_t)TEXTURE_SIZE * TEXTURE_SIZE;
+    // The positions span several periods of the lattice, so that the hashes cover every table entry
+    constexpr float POSITION_RANGE = 1024.0f;
+    // The largest difference that is accepted. The GPU may evaluate the noise with fused multiply-adds
+    // and its own rounding, so the two can not be expected to match exactly.
+    constexpr double MAX_ALLOWED_ERROR = 1e-4;
+    // The exit code when a noise differs by more than "MAX_ALLOWED_ERROR"
+    constexpr int MISMATCH_EXIT_CODE = 2;
+    constexpr int PERMUTATION_SIZE = 256;
+
+    // Relative to the project directory, which Visual Studio runs the tool from
+    const std::string DEFAULT_SHADER_DIRECTORY = "../Water/Source/Shaders/";
+    // The noise of every shader stage lies between these two comments
+    const std::string NOISE_BEGIN = "// Perlin noise";
+    const std::string NOISE_END = "// Noise that was baked on the CPU";
+
+    // A shader file, the stages of it that contain a copy of the noise, and the period that its
+    // Perlin noise wraps its lattice at
+    struct NoiseShader
+    {
+        std::string filename;
+        std::vector<std::string> stages;
+        int perlinPeriod;
+    };
+    const std::array<NoiseShader, 2> NOISE_SHADERS = { {
+        { "Water.shader", { "TessellationEvaluation", "Fragment" }, PERMUTATION_SIZE },
+        // Wraps at "Cube::BAKED_NOISE_PERIOD", so that it matches the noise that the cube bakes
+        { "WaterDistortion.shader", { "Vertex", "Fragment" }, 16 } } };
+
+    // Draws a triangle that covers the whole viewport, without any vertex buffer
+    const std::string VERTEX_SHADER = R"(Vertex
+#version 450 core
+void main()
+{
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+    // "GetRandomIndex" reads the hash policy from the water factors
+    const std::string FRAGMENT_SHADER_BEGIN = R"(Fragment
+#version 450 core
+layout(location = 5) uniform float[9] waterFactors;
+layout(binding = 4) uniform sampler2D positions;
+layout(location = 0) out vec4 noiseValues;
+)";
+
+    // The noises and the hashes that the copy of the noise in a stage contains. Every copy contains Perlin noise.
+    struct NoiseContents
+    {
+        NoiseContents(const std::string& noise)
+            :
+            containsSimplexNoise(noise.find("float SimplexNoise(") != std::string::npos),
+            containsWorleyNoise(noise.find("vec2 WorleyNoise(") != std::string::npos),
+            containsIntegerHash(noise.find("GetIntegerHash(") != std::string::npos)
+        {}
+
+        bool containsSimplexNoise;
+        bool containsWorleyNoise;
+        bool containsIntegerHash;
+    };
+
+    // Samples every noise at the position of the texel. The noises that the stage does not contain are 0.
+    std::string CreateFragmentShaderEnd(const NoiseContents& contents)
+    {
+        return std::string(R"(
+void main()
+{
+    vec3 position = texelFetch(positions, ivec2(gl_FragCoord.xy), 0).xyz;
+    noiseValues = vec4(PerlinNoise(position), )") +
+            (contents.containsSimplexNoise ? "SimplexNoise(position), " : "0.0, ") +
+            (contents.containsWorleyNoise ? "WorleyNoise(position.xz)" : "vec2(0.0)") + ");\n}\n";
+    }
+
+    enum NoiseChannel
+    {
+        PERLIN,
+        SIMPLEX,
+        WORLEY_F1,
+        WORLEY_F2,
+        CHANNEL_COUNT
+    };
+    const std::array<std::string, CHANNEL_COUNT> CHANNEL_NAMES = { "Perlin", "Simplex", "Worley F1", "Worley F2" };
+
+    // The noise evaluated on the CPU, one vector per channel
+    using NoiseValues = std::array<std::vector<float>, CHANNEL_COUNT>;
+
+    struct Positions
+    {
+        std::vector<float> xs;
+        std::vector<float> ys;
+        std::vector<float> zs;
+    };
+
+    struct Error
+    {
+        double max = 0.0;
+        double mean = 0.0;
+    };
+
+    std::string ReadFile(const std::string& filePath)
+    {
+        std::ifstream file(filePath);
+        if (!file)
+        {
+            throw CREATE_CUSTOM_EXCEPTION("Failed to open \"" + filePath + "\"");
+        }
+        std::ostringstream stringStream;
+        stringStream << file.rdbuf();
+        return stringStream.str();
+    }
+
+    // Extracts the noise of a stage in the same way as "Program" splits a shader file into its stages
+    std::string ExtractNoise(const std::string& shaderFile, const std::string& stage)
+    {
+        const std::string stageIdentifier = "#Shader " + stage;
+        const size_t stageBegin = shaderFile.find(stageIdentifier);
+        if (stageBegin == std::string::npos)
+        {
+            throw CREATE_CUSTOM_EXCEPTION("The shader file contains no " + stage + " shader");
+        }
+        const size_t stageEnd = std::min(shaderFile.find("#Shader", stageBegin + stageIdentifier.size()), shaderFile.size());
+
+        const size_t noiseBegin = shaderFile.find(NOISE_BEGIN, stageBegin);
+        const size_t noiseEnd = shaderFile.find(NOISE_END, stageBegin);
+        if (noiseBegin >= stageEnd || noiseEnd >= stageEnd || noiseBegin > noiseEnd)
+        {
+            throw CREATE_CUSTOM_EXCEPTION("The " + stage + " shader contains no noise between \"" + NOISE_BEGIN +
+                "\" and \"" + NOISE_END + "\"");
+        }
+        return shaderFile.substr(noiseBegin, noiseEnd - noiseBegin);
+    }
+
+    GLuint CreateProgram(const std::string& noise, const std::string& shaderFilename, const std::string& stage)
+    {
+        const std::string filename = "NoiseParity (" + shaderFilename + ", " + stage + ")";
+        const Shader vertexShader(VERTEX_SHADER, filename);
+        const Shader fragmentShader(FRAGMENT_SHADER_BEGIN + noise + CreateFragmentShaderEnd(NoiseContents(noise)), filename);
+
+        GLuint program = GL(glCreateProgram());
+        GL(glAttachShader(program, vertexShader.GetShaderName()));
+        GL(glAttachShader(program, fragmentShader.GetShaderName()));
+        GL(glLinkProgram(program));
+
+        int successfullyLinked = 0;
+        GL(glGetProgramiv(program, GL_LINK_STATUS, &successfullyLinked));
+        if (!successfullyLinked)
+        {
+            int logLength = 0;
+            GL(glGetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength));
+            std::string log(std::max(logLength, 1), '\0');
+            GL(glGetProgramInfoLog(program, logLength, NULL, log.data()));
+            GL(glDeleteProgram(program));
+            throw CREATE_CUSTOM_EXCEPTION("Failed to link \"" + filename + "\"\n" + log);
+        }
+        return program;
+    }
+
+    Positions CreatePositions()
+    {
+        noise::SplitMix64 randomNumberGenerator(noise::DEFAULT_SEED);
+        Positions positions;
+        for (std::vector<float>* coordinates : { &positions.xs, &positions.ys, &positions.zs })
+        {
+            coordinates->resize(SAMPLE_COUNT);
+            for (float& coordinate : *coordinates)
+            {
+                coordinate = (randomNumberGenerator.NextFloat() * 2.0f - 1.0f) * POSITION_RANGE;
+            }
+        }
+        return positions;
+    }
+
+    // Evaluates the noise on the CPU, with the same batches as the game uses for its queries
+    template<class HashT>
+    NoiseValues EvaluateOnCpu(const HashT& hash, const Positions& positions)
+    {
+        NoiseValues values;
+
+        values[PERLIN].resize(SAMPLE_COUNT);
+        PerlinNoise<3, PERMUTATION_SIZE, 3, HashT>(hash).GetMany(positions.xs, positions.ys, positions.zs, values[PERLIN]);
+
+        values[SIMPLEX].resize(SAMPLE_COUNT);
+        SimplexNoise<3, PERMUTATION_SIZE, 3, HashT>(hash).GetMany(positions.xs, positions.ys, positions.zs, values[SIMPLEX]);
+
+        // The water is a horizontal plane, so the shader samples the Worley noise in the xz-plane
+        values[WORLEY_F1].resize(SAMPLE_COUNT);
+        WorleyNoise<2, PERMUTATION_SIZE, HashT>(hash, { WorleyMetric::Euclidean, WorleyOutput::F1 }).GetMany(positions.xs, positions.zs, values[WORLEY_F1]);
+        values[WORLEY_F2].resize(SAMPLE_COUNT);
+        WorleyNoise<2, PERMUTATION_SIZE, HashT>(hash, { WorleyMetric::Euclidean, WorleyOutput::F2 }).GetMany(positions.xs, positions.zs, values[WORLEY_F2]);
+
+        return values;
+    }
+
+    // Perlin noise that wraps its lattice at "period", in the same way as the baked noise
+    template<class HashT>
+    std::vector<float> EvaluatePeriodicPerlinOnCpu(const HashT& hash, const Positions& positions, const int period)
+    {
+        const PerlinNoise<3, PERMUTATION_SIZE, 3, HashT> perlinNoise(hash);
+        std::vector<float> values(SAMPLE_COUNT);
+        for (size_t i = 0; i < SAMPLE_COUNT; ++i)
+        {
+            values[i] = perlinNoise.GetWithGradient({ positions.xs[i], positions.ys[i], positions.zs[i] }, period).value;
+        }
+        return values;
+    }
+
+    // Returns the noise that "program" renders, four floats per sample
+    std::vector<float> EvaluateOnGpu(const GLuint program, const GLuint framebuffer, const bool useIntegerHash)
+    {
+        GL(glUseProgram(program));
+        std::array<float, 9> waterFactors = {};
+        waterFactors[7] = useIntegerHash ? 1.0f : 0.0f;
+        GL(glUniform1fv(5, (GLsizei)waterFactors.size(), waterFactors.data()));
+        GL(glUniform1ui(16, noise::IntegerHash<PERMUTATION_SIZE>().GetSeed()));
+
+        GL(glBindFramebuffer(GL_FRAMEBUFFER, framebuffer));
+        GL(glViewport(0, 0, TEXTURE_SIZE, TEXTURE_SIZE));
+        GL(glDrawArrays(GL_TRIANGLES, 0, 3));
+
+        std::vector<float> values(SAMPLE_COUNT * CHANNEL_COUNT);
+        GL(glReadPixels(0, 0, TEXTURE_SIZE, TEXTURE_SIZE, GL_RGBA, GL_FLOAT, values.data()));
+        return values;
+    }
+
+    Error CompareChannel(const std::vector<float>& cpuValues, const std::vector<float>& gpuValues, const NoiseChannel channel)
+    {
+        Error error;
+        for (size_t i = 0; i < SAMPLE_COUNT; ++i)
+        {
+            const double difference = std::abs((double)cpuValues[i] - (double)gpuValues[i * CHANNEL_COUNT + channel]);
+            error.max = std::max(error.max, difference);
+            error.mean += difference;
+        }
+        error.mean /= (double)SAMPLE_COUNT;
+        return error;
+    }
+
+    GLuint CreateFloatTexture(const float* data)
+    {
+        GLuint texture = 0;
+        GL(glCreateTextures(GL_TEXTURE_2D, 1, &texture));
+        GL(glTextureStorage2D(texture, 1, GL_RGBA32F, TEXTURE_SIZE, TEXTURE_SIZE));
+        if (data)
+        {
+            GL(glTextureSubImage2D(texture, 0, 0, 0, TEXTURE_SIZE, TEXTURE_SIZE, GL_RGBA, GL_FLOAT, data));
+        }
+        // The positions are fetched texel by texel
+        GL(glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+        GL(glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+        return texture;
+    }
+
+    GLuint CreatePermutationTexture(const PermutationTable<PERMUTATION_SIZE>& permutationTable)
+    {
+        // The texture stores the indices as bytes, in the same way as "Water" does
+        std::vector<unsigned char> permutationBytes(permutationTable.Size());
+        for (size_t i = 0; i < permutationBytes.size(); ++i)
+        {
+            permutationBytes[i] = (unsigned char)permutationTable[i];
+        }
+
+        GLuint texture = 0;
+        GL(glCreateTextures(GL_TEXTURE_1D, 1, &texture));
+        GL(glTextureStorage1D(texture, 1, GL_R8UI, (GLsizei)permutationBytes.size()));
+        GL(glTextureSubImage1D(texture, 0, 0, (GLsizei)permutationBytes.size(), GL_RED_INTEGER,
+            GL_UNSIGNED_BYTE, permutationBytes.data()));
+        // Integer textures cannot be filtered, and are incomplete unless the filtering is nearest
+        GL(glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+        GL(glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+        return texture;
+    }
+
+    // Creates an OpenGL context without showing a window
+    GLFWwindow* CreateHiddenWindow()
+    {
+        if (!glfwInit())
+        {
+            throw CREATE_CUSTOM_EXCEPTION("Failed to initialize GLFW");
+        }
+
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        GLFWwindow* window = glfwCreateWindow(1, 1, "NoiseParity", NULL, NULL);
+        if (!window)
+        {
+            glfwTerminate();
+            throw CREATE_CUSTOM_EXCEPTION("Failed to create the GLFW window");
+        }
+        glfwMakeContextCurrent(window);
+
+        GLenum status = glewInit();
+        if (GLEW_OK != status)
+        {
+            std::string errorString = reinterpret_cast<const char*>(glewGetErrorString(status));
+            throw CREATE_CUSTOM_EXCEPTION("Failed to initialize GLEW\n" + errorString);
+        }
+        return window;
+    }
+
+    // Whether the copy of the noise in a stage can produce the channel with the hash
+    bool ContainsChannel(const NoiseContents& contents, const NoiseChannel channel, const bool useIntegerHash)
+    {
+        if (useIntegerHash && !contents.containsIntegerHash)
+        {
+            return false;
+        }
+        switch (channel)
+        {
+        case SIMPLEX:
+            return contents.containsSimplexNoise;
+        case WORLEY_F1:
+        case WORLEY_F2:
+            return contents.containsWorleyNoise;
+        default:
+            return true;
+        }
+    }
+
+    // Renders the noise of every stage of every shader in "shaderDirectory" and compares it against
+    // the CPU. Returns whether every difference is within "MAX_ALLOWED_ERROR".
+    bool CompareNoise(const std::string& shaderDirectory, std::ostringstream& table)
+    {
+        const std::shared_ptr<const PermutationTable<PERMUTATION_SIZE>> permutationTable =
+            NoiseTableRegistry::GetPermutationTable<PERMUTATION_SIZE>();
+
+        const Positions positions = CreatePositions();
+        const noise::PermutationHash<PERMUTATION_SIZE> permutationHash(permutationTable);
+        const noise::IntegerHash<PERMUTATION_SIZE> integerHash;
+        const std::array<NoiseValues, 2> cpuValues = {
+            EvaluateOnCpu(permutationHash, positions),
+            EvaluateOnCpu(integerHash, positions) };
+
+        // The positions are passed in as an RGBA texture
+        std::vector<float> positionTexels(SAMPLE_COUNT * 4, 0.0f);
+        for (size_t i = 0; i < SAMPLE_COUNT; ++i)
+        {
+            positionTexels[i * 4] = positions.xs[i];
+            positionTexels[i * 4 + 1] = positions.ys[i];
+            positionTexels[i * 4 + 2] = positions.zs[i];
+        }
+        const GLuint positionTexture = CreateFloatTexture(positionTexels.data());
+        const GLuint noiseTexture = CreateFloatTexture(nullptr);
+        const GLuint permutationTexture = CreatePermutationTexture(*permutationTable);
+        GL(glBindTextureUnit(0, permutationTexture));
+        GL(glBindTextureUnit(4, positionTexture));
+
+        GLuint framebuffer = 0;
+        GL(glCreateFramebuffers(1, &framebuffer));
+        GL(glNamedFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, noiseTexture, 0));
+        if (glCheckNamedFramebufferStatus(framebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            throw CREATE_CUSTOM_EXCEPTION("The noise framebuffer is incomplete");
+        }
+        // The core profile can not draw without a vertex array
+        GLuint vertexArray = 0;
+        GL(glCreateVertexArrays(1, &vertexArray));
+        GL(glBindVertexArray(vertexArray));
+
+        bool withinAllowedError = true;
+        for (const NoiseShader& noiseShader : NOISE_SHADERS)
+        {
+            const std::string shaderFile = ReadFile(shaderDirectory + noiseShader.filename);
+            const bool isPerlinPeriodic = noiseShader.perlinPeriod != PERMUTATION_SIZE;
+            std::array<std::vector<float>, 2> periodicPerlinValues;
+            if (isPerlinPeriodic)
+            {
+                periodicPerlinValues = {
+                    EvaluatePeriodicPerlinOnCpu(permutationHash, positions, noiseShader.perlinPeriod),
+                    EvaluatePeriodicPerlinOnCpu(integerHash, positions, noiseShader.perlinPeriod) };
+            }
+
+            for (const std::string& stage : noiseShader.stages)
+            {
+                const std::string noise = ExtractNoise(shaderFile, stage);
+                const NoiseContents contents(noise);
+                const GLuint program = CreateProgram(noise, noiseShader.filename, stage);
+
+                for (const bool useIntegerHash : { false, true })
+                {
+                    const std::vector<float> gpuValues = EvaluateOnGpu(program, framebuffer, useIntegerHash);
+                    const NoiseValues& cpuValuesOfHash = cpuValues[useIntegerHash];
+                    for (int channel = 0; channel < CHANNEL_COUNT; ++channel)
+                    {
+                        table << std::setw(24) << noiseShader.filename << std::setw(24) << stage <<
+                            std::setw(13) << (useIntegerHash ? "Integer" : "Permutation") << std::setw(11) << CHANNEL_NAMES[channel];
+
+                        // The stages that do not contain the noise or the hash leave the channel empty
+                        if (!ContainsChannel(contents, (NoiseChannel)channel, useIntegerHash))
+                        {
+                            table << std::setw(28) << "not compared" << "\n";
+                            continue;
+                        }
+
+                        const std::vector<float>& cpuChannelValues = channel == PERLIN && isPerlinPeriodic ?
+                            periodicPerlinValues[useIntegerHash] : cpuValuesOfHash[channel];
+                        const Error error = CompareChannel(cpuChannelValues, gpuValues, (NoiseChannel)channel);
+                        withinAllowedError = withinAllowedError && error.max <= MAX_ALLOWED_ERROR;
+                        table << std::setw(14) << error.max << std::setw(14) << error.mean <<
+                            (error.max <= MAX_ALLOWED_ERROR ? "" : "  MISMATCH") << "\n";
+                    }
+                }
+                GL(glDeleteProgram(program));
+            }
+        }
+
+        GL(glDeleteVertexArrays(1, &vertexArray));
+        GL(glDeleteFramebuffers(1, &framebuffer));
+        const std::array<GLuint, 3> textures = { positionTexture, noiseTexture, permutationTexture };
+        GL(glDeleteTextures((GLsizei)textures.size(), textures.data()));
+        return withinAllowedError;
+    }
+}
+
+// Renders the GLSL noise of the shaders in "NOISE_SHADERS" into an offscreen float texture, and
+// compares it against the batch evaluation on the CPU. The CPU queries, e.g., the altitude of the
+// water under an object, can only trust the CPU noise if it matches what gets drawn. Takes the
+// directory of the shaders as an optional argument, and exits with "MISMATCH_EXIT_CODE" if any of
+// the noise differs by more than "MAX_ALLOWED_ERROR".
+int main(int argc, char* argv[])
+{
+    GLFWwindow* window = nullptr;
+    int exitCode = 0;
+    try
+    {
+        const std::string shaderDirectory = argc > 1 ? std::string(argv[1]) + "/" : DEFAULT_SHADER_DIRECTORY;
+        window = CreateHiddenWindow();
+
+        std::ostringstream table;
+        table << std::scientific << std::setprecision(3);
+        table << "The GLSL noise of the shaders in \"" << shaderDirectory << "\" against the CPU (" <<
+            simd::GetInstructionSetName(simd::GetInstructionSet()) << ") over " << SAMPLE_COUNT << " samples on " <<
+            reinterpret_cast<const char*>(glGetString(GL_RENDERER)) << "\n";
+        table << std::setw(24) << "Shader" << std::setw(24) << "Stage" << std::setw(13) << "Hash" << std::setw(11) << "Noise" <<
+            std::setw(14) << "Max error" << std::setw(14) << "Mean error" << "\n";
+
+        const bool withinAllowedError = CompareNoise(shaderDirectory, table);
+        LOG(table.str());
+        if (!withinAllowedError)
+        {
+            ERROR_LOG("The GLSL noise differs from the CPU by more than " + std::to_string(MAX_ALLOWED_ERROR));
+            exitCode = MISMATCH_EXIT_CODE;
+        }
+    }
+    catch (const CustomException& exception)
+    {
+        ERROR_LOG(exception.what());
+        exitCode = 1;
+    }
+    catch (const std::exception& exception)
+    {
+        ERROR_LOG(exception.what());
+        exitCode = 1;
+    }
+
+    if (window)
+    {
+        glfwDestroyWindow(window);
+    }
+    glfwTerminate();
+    return exitCode;
+}
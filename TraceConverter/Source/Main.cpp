@@ -0,0 +1,82 @@
+#include "Source/Benchmark/BenchmarkTraceReader.h"
+#include "Source/Benchmark/BenchmarkEventFactory.h"
+#include "Source/CustomException.h"
+#include "Source/Console/ErrorLog.h"
+#include "Source/Console/Log.h"
+#include <filesystem>
+
+// Converts a binary benchmark trace, written by "benchmark::Manager", into
+// a JSON file that can be opened inside "chrome://tracing"
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        ERROR_LOG("Usage: TraceConverter <trace.bin> [output.json]");
+        return 1;
+    }
+
+    const std::string inputPath = argv[1];
+    // If no output path is given, the JSON file is placed next to the trace
+    const std::string outputPath = argc > 2 ? 
+        argv[2] : std::filesystem::path(inputPath).replace_extension(".json").string();
+
+    try
+    {
+        std::ofstream outputFile;
+        // Make the file stream throw exceptions
+        outputFile.exceptions(std::ios::badbit | std::ios::failbit);
+        outputFile.open(outputPath, std::ios::binary);
+
+        // The events get written in the same layout as the benchmark
+        // subsystem used before it switched to the binary trace format
+        outputFile << "[";
+        auto writeEvent = [&outputFile](const benchmark::Event& event)
+        {
+            outputFile << event.GetData() + ",\n";
+        };
+
+        size_t nTimings = 0;
+        benchmark::TraceReader traceReader(inputPath);
+        traceReader.Read({
+            [&](const benchmark::data::Session& data, unsigned int processId)
+            {
+                writeEvent(benchmark::EventFactory::CreateSession(data, processId));
+            },
+            [&](const benchmark::data::Thread& data, unsigned int processId)
+            {
+                writeEvent(benchmark::EventFactory::CreateThread(data, processId));
+            },
+            [&](const benchmark::data::Timing& data, const std::string& scopeName, unsigned int processId)
+            {
+                writeEvent(benchmark::EventFactory::CreateTiming(data, scopeName, processId));
+                ++nTimings;
+            },
+            [&](const benchmark::data::Frame& data, unsigned int processId)
+            {
+                writeEvent(benchmark::EventFactory::CreateFrame(data, processId));
+                if (data.isHitch)
+                {
+                    writeEvent(benchmark::EventFactory::CreateHitch(data, processId));
+                }
+            },
+            [&](const benchmark::data::Counter& data, const std::string& counterName, unsigned int processId)
+            {
+                writeEvent(benchmark::EventFactory::CreateCounter(data, counterName, processId));
+            }
+        });
+
+        LOG("Converted " << nTimings << " timings into: " << outputPath << std::endl);
+    }
+    catch (const CustomException& exception)
+    {
+        ERROR_LOG(exception.what());
+        return 1;
+    }
+    catch (const std::exception& exception)
+    {
+        ERROR_LOG(exception.what());
+        return 1;
+    }
+
+    return 0;
+}
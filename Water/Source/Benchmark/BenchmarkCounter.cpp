@@ -0,0 +1,56 @@
+#include "BenchmarkCounter.h"
+#include "BenchmarkManager.h"
+
+benchmark::Counter::Counter(const std::string& name, CounterKind kind)
+	:
+	Counter(name, nullptr, kind)
+{
+}
+
+benchmark::Counter::Counter(const std::string& name, std::function<double()> source, CounterKind kind)
+	:
+	mDescriptor(name.c_str(), ScopeKind::Counter),
+	mKind(kind),
+	mSource(source)
+{
+	Manager::Get().RegisterCounter(*this);
+}
+
+benchmark::Counter::~Counter()
+{
+	Manager::Get().UnregisterCounter(*this);
+}
+
+void benchmark::Counter::Set(double value)
+{
+	mValue.store(value, std::memory_order_relaxed);
+}
+
+void benchmark::Counter::Add(double value)
+{
+	mValue.fetch_add(value, std::memory_order_relaxed);
+}
+
+double benchmark::Counter::Sample(double secondsSinceLastSample)
+{
+	const double total = mSource ? mSource() : mValue.load(std::memory_order_relaxed);
+	if (mKind == CounterKind::Value)
+	{
+		return total;
+	}
+
+	const double increase = total - mPreviousTotal;
+	mPreviousTotal = total;
+
+	if (mKind == CounterKind::PerFrame)
+	{
+		return increase;
+	}
+	// The very first sample does not know how much time has passed
+	return secondsSinceLastSample > 0.0 ? increase / secondsSinceLastSample : 0.0;
+}
+
+unsigned int benchmark::Counter::GetId() const
+{
+	return mDescriptor.id;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include "BenchmarkScope.h"
+
+namespace benchmark
+{
+	enum class CounterKind
+	{
+		// Publishes the current value
+		Value,
+		// Publishes how much the value has increased since the previous frame
+		PerFrame,
+		// Publishes how much the value has increased per second since the previous frame
+		PerSecond
+	};
+
+	// A numeric series that gets sampled once per frame by "Manager", e.g., the number of drawn patches.
+	// The counter registers itself with the manager for as long as it exists.
+	class Counter
+	{
+	public:
+		// The value gets published through Set() and Add()
+		Counter(const std::string& name, CounterKind kind = CounterKind::Value);
+		// The value gets read from "source" whenever the counter is sampled. For "PerFrame" and
+		// "PerSecond", "source" should return a running total. "source" has to be thread-safe.
+		Counter(const std::string& name, std::function<double()> source, CounterKind kind = CounterKind::Value);
+		~Counter();
+		// One should not be able to copy nor move a "Counter" instance, since the manager refers to it
+		Counter(const Counter& other) = delete;
+		Counter& operator=(const Counter& other) = delete;
+
+		// Thread-safe and lock-free
+		void Set(double value);
+		// Thread-safe and lock-free
+		void Add(double value);
+
+		// Should only get called by "Manager"
+		double Sample(double secondsSinceLastSample);
+		unsigned int GetId() const;
+	private:
+		const ScopeDescriptor mDescriptor;
+		const CounterKind mKind;
+		const std::function<double()> mSource;
+		std::atomic<double> mValue = 0.0;
+		// The running total at the previous sample. Only used by "PerFrame" and "PerSecond".
+		double mPreviousTotal = 0.0;
+	};
+}
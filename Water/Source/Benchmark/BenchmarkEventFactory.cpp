@@ -1,11 +1,12 @@
 #include "BenchmarkEventFactory.h"
+#include <sstream>
+#include <iomanip>
 
-benchmark::Event benchmark::EventFactory::CreateTiming(const data::Timing& data, unsigned int processId)
+benchmark::Event benchmark::EventFactory::CreateTiming(const data::Timing& data, const std::string& name, unsigned int processId)
 {
-
     return Event({ 
-        { "name", "\"" + data.name + "\""}, {"cat", "\"Function\""}, {"ph", "\"X\""}, 
-        {"ts", std::to_string(data.timepoint)}, {"dur", std::to_string(data.duration)},
+        { "name", "\"" + name + "\""}, {"cat", "\"Function\""}, {"ph", "\"X\""}, 
+        {"ts", FormatMicroseconds(data.timepoint)}, {"dur", FormatMicroseconds(data.duration)},
         {"pid", std::to_string(processId)}, {"tid", std::to_string(data.threadId)}
         });
 }
@@ -25,4 +26,54 @@ benchmark::Event benchmark::EventFactory::CreateThread(const data::Thread& data,
         {"pid", std::to_string(processId)}, {"args", "{\"name\": \"" + data.name + "\"}"}, 
         {"tid", std::to_string(data.threadId)}
         });
+}
+
+benchmark::Event benchmark::EventFactory::CreateFrame(const data::Frame& data, unsigned int processId)
+{
+    // The phase breakdown is shown when the frame is selected
+    std::string phases;
+    for (size_t i = 0; i < data.phaseDurations.size(); i++)
+    {
+        phases += (i == 0 ? "" : ", ") + std::string("\"") + GetFramePhaseName((FramePhase)i) + " (us)\": " +
+            FormatMicroseconds(data.phaseDurations[i]);
+    }
+
+    return Event({
+        { "name", "\"Frame " + std::to_string(data.number) + "\""}, {"cat", "\"Frame\""}, {"ph", "\"X\""},
+        {"ts", FormatMicroseconds(data.timepoint)}, {"dur", FormatMicroseconds(data.duration)},
+        {"pid", std::to_string(processId)}, {"tid", std::to_string(data.threadId)}, {"args", "{" + phases + "}"}
+        });
+}
+
+benchmark::Event benchmark::EventFactory::CreateHitch(const data::Frame& data, unsigned int processId)
+{
+    return Event({
+        { "name", "\"Hitch\""}, {"cat", "\"Frame\""}, {"ph", "\"i\""}, {"s", "\"p\""},
+        {"ts", FormatMicroseconds(data.timepoint)}, {"pid", std::to_string(processId)}, 
+        {"tid", std::to_string(data.threadId)}, 
+        {"args", "{\"Frame\": " + std::to_string(data.number) + ", \"Duration (us)\": " + FormatMicroseconds(data.duration) + "}"}
+        });
+}
+
+benchmark::Event benchmark::EventFactory::CreateCounter(const data::Counter& data, const std::string& name, unsigned int processId)
+{
+    std::ostringstream value;
+    // Enough digits to not lose any precision
+    value << std::setprecision(17) << data.value;
+
+    return Event({
+        { "name", "\"" + name + "\""}, {"cat", "\"Counter\""}, {"ph", "\"C\""},
+        {"ts", FormatMicroseconds(data.timepoint)}, {"pid", std::to_string(processId)},
+        {"args", "{\"value\": " + value.str() + "}"}
+        });
+}
+
+std::string benchmark::EventFactory::FormatMicroseconds(long long nanoseconds)
+{
+    assert(nanoseconds >= 0);
+
+    // Always write three decimals, in order to keep the nanosecond precision
+    std::string fraction = std::to_string(nanoseconds % 1000);
+    fraction.insert(0, 3 - fraction.size(), '0');
+    return std::to_string(nanoseconds / 1000) + "." + fraction;
 }
\ No newline at end of file
@@ -7,8 +7,15 @@ namespace benchmark
 	class EventFactory
 	{
 	public:
-		static Event CreateTiming(const data::Timing& data, unsigned int processId);
+		static Event CreateTiming(const data::Timing& data, const std::string& name, unsigned int processId);
 		static Event CreateSession(const data::Session& data, unsigned int processId);
 		static Event CreateThread(const data::Thread& data, unsigned int processId);
+		static Event CreateFrame(const data::Frame& data, unsigned int processId);
+		// An instant event that marks a frame that exceeded the frame budget
+		static Event CreateHitch(const data::Frame& data, unsigned int processId);
+		static Event CreateCounter(const data::Counter& data, const std::string& name, unsigned int processId);
+	private:
+		// The trace event format expects microseconds, but accepts fractions of them
+		static std::string FormatMicroseconds(long long nanoseconds);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+namespace benchmark
+{
+	// The parts that a frame is broken down into
+	enum class FramePhase
+	{
+		Update,
+		Render,
+		PostProcess,
+		// Includes the polling of the window events
+		Swap,
+		Count
+	};
+	inline constexpr size_t FRAME_PHASE_COUNT = (size_t)FramePhase::Count;
+
+	constexpr const char* GetFramePhaseName(FramePhase phase)
+	{
+		switch (phase)
+		{
+		case FramePhase::Update:
+			return "Update";
+		case FramePhase::Render:
+			return "Render";
+		case FramePhase::PostProcess:
+			return "Post-process";
+		case FramePhase::Swap:
+			return "Swap";
+		default:
+			return "Unknown";
+		}
+	}
+}
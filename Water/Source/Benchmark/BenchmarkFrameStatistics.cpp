@@ -0,0 +1,110 @@
+#include "BenchmarkFrameStatistics.h"
+#include <sstream>
+#include <iomanip>
+
+void benchmark::FrameStatistics::SetBudget(long long nanoseconds)
+{
+	assert(nanoseconds > 0);
+	mBudget = nanoseconds;
+}
+
+void benchmark::FrameStatistics::AddPhase(const data::Timing& data, FramePhase phase)
+{
+	assert(phase != FramePhase::Count);
+
+	// A phase may be entered several times during a frame
+	mThreadIdToPhaseDurations[data.threadId][(size_t)phase] += data.duration;
+}
+
+benchmark::data::Frame benchmark::FrameStatistics::AddFrame(const data::Timing& data)
+{
+	std::array<long long, FRAME_PHASE_COUNT> phaseDurations = {};
+	const auto it = mThreadIdToPhaseDurations.find(data.threadId);
+	if (it != mThreadIdToPhaseDurations.end())
+	{
+		phaseDurations = it->second;
+		mThreadIdToPhaseDurations.erase(it);
+	}
+
+	const data::Frame frame(mFrameCount++, data.timepoint, data.duration, data.threadId, 
+							phaseDurations, data.duration > mBudget);
+
+	mFrameTimes.Add(frame.duration);
+	mMaxFrameTime = std::max(mMaxFrameTime, frame.duration);
+	for (size_t i = 0; i < FRAME_PHASE_COUNT; i++)
+	{
+		mTotalPhaseTimes[i] += phaseDurations[i];
+	}
+
+	if (frame.isHitch)
+	{
+		mHitchCount++;
+
+		// Keep the longest hitches
+		const auto position = std::find_if(mWorstHitches.begin(), mWorstHitches.end(), 
+			[&frame](const data::Frame& hitch) { return hitch.duration < frame.duration; });
+		if (position != mWorstHitches.end() || mWorstHitches.size() < MAX_REPORTED_HITCHES)
+		{
+			mWorstHitches.insert(position, frame);
+			if (mWorstHitches.size() > MAX_REPORTED_HITCHES)
+			{
+				mWorstHitches.pop_back();
+			}
+		}
+	}
+
+	return frame;
+}
+
+std::string benchmark::FrameStatistics::CreateReport() const
+{
+	auto toMilliseconds = [](long long nanoseconds) { return (double)nanoseconds / 1e+6; };
+	// The histogram only knows which bucket a value fell into, so the percentiles are clamped to the known range
+	auto getPercentile = [this](double percentile)
+	{
+		return std::min(mFrameTimes.GetPercentile(percentile), mMaxFrameTime);
+	};
+
+	std::ostringstream report;
+	report << std::fixed << std::setprecision(3)
+		<< "Frames: " << mFrameCount << std::endl
+		<< "Budget (ms): " << toMilliseconds(mBudget) << std::endl
+		<< "Hitches: " << mHitchCount << std::endl
+		<< "Frame time (ms): p50 " << toMilliseconds(getPercentile(50.0)) 
+		<< ", p90 " << toMilliseconds(getPercentile(90.0))
+		<< ", p99 " << toMilliseconds(getPercentile(99.0)) 
+		<< ", max " << toMilliseconds(mMaxFrameTime) << std::endl;
+
+	if (mFrameCount == 0)
+	{
+		return report.str();
+	}
+
+	report << "Average phase time (ms):" << std::endl;
+	for (size_t i = 0; i < FRAME_PHASE_COUNT; i++)
+	{
+		report << "  " << std::setw(14) << std::left << GetFramePhaseName((FramePhase)i) << std::right
+			<< toMilliseconds(mTotalPhaseTimes[i] / (long long)mFrameCount) << std::endl;
+	}
+
+	if (!mWorstHitches.empty())
+	{
+		report << "Worst hitches (ms):" << std::endl;
+		for (const data::Frame& hitch : mWorstHitches)
+		{
+			report << "  Frame " << hitch.number << ": " << toMilliseconds(hitch.duration);
+			for (size_t i = 0; i < FRAME_PHASE_COUNT; i++)
+			{
+				report << ", " << GetFramePhaseName((FramePhase)i) << " " << toMilliseconds(hitch.phaseDurations[i]);
+			}
+			report << std::endl;
+		}
+	}
+
+	return report.str();
+}
+
+unsigned long long benchmark::FrameStatistics::GetFrameCount() const
+{
+	return mFrameCount;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Data/All.h"
+#include "BenchmarkHistogram.h"
+
+namespace benchmark
+{
+	// Breaks the frames down into their phases and keeps track of the frames that exceed the budget
+	class FrameStatistics
+	{
+	public:
+		void SetBudget(long long nanoseconds);
+		// The phases of a frame need to be added before the frame itself, i.e., in the order they ended
+		void AddPhase(const data::Timing& data, FramePhase phase);
+		// Completes the frame with the phases that have been added on the frame's thread
+		data::Frame AddFrame(const data::Timing& data);
+		// Creates a report of the frame time percentiles, the average phase times and the worst hitches
+		std::string CreateReport() const;
+		unsigned long long GetFrameCount() const;
+	private:
+		static constexpr long long DEFAULT_BUDGET = 16'600'000;
+		// The number of hitches that are listed inside the report
+		static constexpr size_t MAX_REPORTED_HITCHES = 10;
+
+		long long mBudget = DEFAULT_BUDGET;
+		unsigned long long mFrameCount = 0;
+		unsigned long long mHitchCount = 0;
+		Histogram mFrameTimes;
+		long long mMaxFrameTime = 0;
+		// Indexed by "FramePhase"
+		std::array<long long, FRAME_PHASE_COUNT> mTotalPhaseTimes = {};
+		// The phases of the frames that have not yet ended
+		std::unordered_map<unsigned int, std::array<long long, FRAME_PHASE_COUNT>> mThreadIdToPhaseDurations;
+		// Sorted by duration, longest first
+		std::vector<data::Frame> mWorstHitches;
+	};
+}
@@ -0,0 +1,191 @@
+#include "BenchmarkGpuProfiler.h"
+#include "BenchmarkManager.h"
+#include "BenchmarkTscClock.h"
+#include "../Rendering/GlMacro.h"
+#include "../Console/Log.h"
+
+namespace
+{
+	bool IsQueryTargetSupported(GLenum target)
+	{
+		// The pipeline statistics, e.g., "GL_TESS_EVALUATION_SHADER_INVOCATIONS", are core since OpenGL 4.6
+		const bool isPipelineStatistic = target >= GL_VERTICES_SUBMITTED && target <= GL_CLIPPING_OUTPUT_PRIMITIVES;
+		return !isPipelineStatistic || GLEW_VERSION_4_6 || GLEW_ARB_pipeline_statistics_query;
+	}
+}
+
+benchmark::GpuProfiler::GpuProfiler()
+{
+	Manager::Get().NameThread(data::Thread("GPU", GPU_THREAD_ID));
+	Calibrate();
+}
+
+benchmark::GpuProfiler& benchmark::GpuProfiler::Get()
+{
+	static GpuProfiler instance;
+	return instance;
+}
+
+benchmark::GpuProfiler::Scope benchmark::GpuProfiler::Begin(const ScopeDescriptor& scope)
+{
+	const Scope gpuScope{ scope.id, AcquireQuery(), AcquireQuery() };
+	// The timestamp gets recorded once the GPU has finished all of the previously issued commands
+	GL(glQueryCounter(gpuScope.startQuery, GL_TIMESTAMP));
+	return gpuScope;
+}
+
+void benchmark::GpuProfiler::End(const Scope& scope)
+{
+	// Not using the "GL" macro, since it may throw
+	glQueryCounter(scope.endQuery, GL_TIMESTAMP);
+	mEndedScopes.push_back(scope);
+}
+
+void benchmark::GpuProfiler::Collect()
+{
+	if (++mCollectsSinceCalibration == CALIBRATION_INTERVAL)
+	{
+		Calibrate();
+	}
+
+	while (!mEndedScopes.empty())
+	{
+		const Scope& scope = mEndedScopes.front();
+
+		// The queries finish in the order they were issued. If this result is not yet available,
+		// neither are the results of the later scopes.
+		GLint isAvailable = GL_FALSE;
+		GL(glGetQueryObjectiv(scope.endQuery, GL_QUERY_RESULT_AVAILABLE, &isAvailable));
+		if (!isAvailable)
+		{
+			break;
+		}
+
+		GLuint64 startTimestamp = 0;
+		GLuint64 endTimestamp = 0;
+		GL(glGetQueryObjectui64v(scope.startQuery, GL_QUERY_RESULT, &startTimestamp));
+		GL(glGetQueryObjectui64v(scope.endQuery, GL_QUERY_RESULT, &endTimestamp));
+
+		// The scopes are handed over in the order they ended, just like the scopes of the CPU threads
+		Manager::Get().Benchmark(data::Timing(scope.scopeId, (long long)startTimestamp + mGpuToCpuOffset,
+											  (long long)(endTimestamp - startTimestamp), GPU_THREAD_ID));
+
+		mFreeQueries.push_back(scope.startQuery);
+		mFreeQueries.push_back(scope.endQuery);
+		mEndedScopes.pop_front();
+	}
+
+	for (GpuQueryCounter* queryCounter : mQueryCounters)
+	{
+		queryCounter->Collect();
+	}
+}
+
+void benchmark::GpuProfiler::RegisterQueryCounter(GpuQueryCounter& queryCounter)
+{
+	mQueryCounters.push_back(&queryCounter);
+}
+
+void benchmark::GpuProfiler::UnregisterQueryCounter(GpuQueryCounter& queryCounter)
+{
+	mQueryCounters.erase(std::remove(mQueryCounters.begin(), mQueryCounters.end(), &queryCounter), mQueryCounters.end());
+}
+
+GLuint benchmark::GpuProfiler::AcquireQuery()
+{
+	if (mFreeQueries.empty())
+	{
+		mFreeQueries.resize(QUERY_BATCH_SIZE);
+		GL(glCreateQueries(GL_TIMESTAMP, (GLsizei)QUERY_BATCH_SIZE, mFreeQueries.data()));
+	}
+
+	const GLuint query = mFreeQueries.back();
+	mFreeQueries.pop_back();
+	return query;
+}
+
+void benchmark::GpuProfiler::Calibrate()
+{
+	mCollectsSinceCalibration = 0;
+
+	// Reading the GPU's clock directly does not wait for the issued commands to finish
+	GLint64 gpuTimestamp = 0;
+	GL(glGetInteger64v(GL_TIMESTAMP, &gpuTimestamp));
+	const long long cpuTimestamp = TscClock::now().time_since_epoch().count();
+
+	mGpuToCpuOffset = cpuTimestamp - (long long)gpuTimestamp;
+}
+
+benchmark::GpuQueryCounter::GpuQueryCounter(const std::string& name, GLenum target)
+	:
+	mCounter(name, CounterKind::PerFrame),
+	mTarget(target),
+	mIsSupported(IsQueryTargetSupported(target))
+{
+	if (!mIsSupported)
+	{
+		LOG("The driver does not support the query of the counter \"" << name << "\", so it stays at 0" << std::endl);
+	}
+	GpuProfiler::Get().RegisterQueryCounter(*this);
+}
+
+benchmark::GpuQueryCounter::~GpuQueryCounter()
+{
+	GpuProfiler::Get().UnregisterQueryCounter(*this);
+}
+
+void benchmark::GpuQueryCounter::Begin()
+{
+	if (!mIsSupported)
+	{
+		return;
+	}
+
+	// Only one query per target can be active at a time
+	assert(mActiveQuery == 0);
+
+	if (mFreeQueries.empty())
+	{
+		mFreeQueries.resize(1);
+		GL(glCreateQueries(mTarget, 1, mFreeQueries.data()));
+	}
+	mActiveQuery = mFreeQueries.back();
+	mFreeQueries.pop_back();
+
+	GL(glBeginQuery(mTarget, mActiveQuery));
+}
+
+void benchmark::GpuQueryCounter::End()
+{
+	if (!mIsSupported)
+	{
+		return;
+	}
+
+	// Not using the "GL" macro, since it may throw
+	glEndQuery(mTarget);
+	mEndedQueries.push_back(mActiveQuery);
+	mActiveQuery = 0;
+}
+
+void benchmark::GpuQueryCounter::Collect()
+{
+	while (!mEndedQueries.empty())
+	{
+		const GLuint query = mEndedQueries.front();
+
+		GLint isAvailable = GL_FALSE;
+		GL(glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &isAvailable));
+		if (!isAvailable)
+		{
+			break;
+		}
+
+		GLuint64 result = 0;
+		GL(glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result));
+		mCounter.Add((double)result);
+
+		mFreeQueries.push_back(query);
+		mEndedQueries.pop_front();
+	}
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include "GL/glew.h"
+#include <deque>
+#include "BenchmarkScope.h"
+#include "BenchmarkCounter.h"
+
+namespace benchmark
+{
+	// The timings of the GPU are shown as a separate thread with this id
+	inline constexpr unsigned int GPU_THREAD_ID = std::numeric_limits<unsigned int>::max();
+
+	class GpuQueryCounter;
+
+	// Measures how long the GPU spends on scopes, using timestamp queries. The results only
+	// become available a few frames later, so they are collected without stalling the CPU.
+	// Singleton. Should only be used on the thread that owns the GL context.
+	class GpuProfiler
+	{
+	public:
+		// The queries of a scope that has begun
+		struct Scope
+		{
+			unsigned int scopeId = 0;
+			GLuint startQuery = 0;
+			GLuint endQuery = 0;
+		};
+	public:
+		static GpuProfiler& Get();
+		// One should not be able to copy nor move a "GpuProfiler" instance
+		GpuProfiler(const GpuProfiler& other) = delete;
+		GpuProfiler& operator=(const GpuProfiler& other) = delete;
+
+		Scope Begin(const ScopeDescriptor& scope);
+		// Does not throw, since it gets called from destructors
+		void End(const Scope& scope);
+		// Should get called once per frame. Hands the scopes whose results have
+		// become available to "Manager" and recycles their queries. Also collects the query counters.
+		void Collect();
+		void RegisterQueryCounter(GpuQueryCounter& queryCounter);
+		void UnregisterQueryCounter(GpuQueryCounter& queryCounter);
+	private:
+		GpuProfiler();
+		GLuint AcquireQuery();
+		// Measures the offset between the GPU's clock and "TscClock"
+		void Calibrate();
+	private:
+		// The number of queries that get created whenever the pool runs out
+		static constexpr size_t QUERY_BATCH_SIZE = 64;
+		// The number of calls to Collect() between each calibration, since the clocks drift apart
+		static constexpr unsigned int CALIBRATION_INTERVAL = 256;
+
+		// The queries are never deleted, since the GL context may already be destroyed
+		// when the singleton gets destroyed
+		std::vector<GLuint> mFreeQueries;
+		// The scopes that have ended, in the order they ended, but whose results have not yet been collected
+		std::deque<Scope> mEndedScopes;
+		long long mGpuToCpuOffset = 0;
+		unsigned int mCollectsSinceCalibration = 0;
+		std::vector<GpuQueryCounter*> mQueryCounters;
+	};
+
+	// Publishes the results of a GL query as a per-frame counter, e.g., the number of tessellation 
+	// evaluation shader invocations. Just like the timestamps, the results are collected a few frames later.
+	// Does nothing when the driver does not support the target of the query.
+	class GpuQueryCounter
+	{
+	public:
+		// "target" is the target of the query, e.g., "GL_TESS_EVALUATION_SHADER_INVOCATIONS"
+		GpuQueryCounter(const std::string& name, GLenum target);
+		~GpuQueryCounter();
+		// One should not be able to copy nor move a "GpuQueryCounter" instance, since the profiler refers to it
+		GpuQueryCounter(const GpuQueryCounter& other) = delete;
+		GpuQueryCounter& operator=(const GpuQueryCounter& other) = delete;
+
+		void Begin();
+		// Does not throw, since it gets called from destructors
+		void End();
+		// Adds the results that have become available to the counter
+		void Collect();
+	private:
+		Counter mCounter;
+		const GLenum mTarget;
+		const bool mIsSupported;
+		// The queries are never deleted, since the GL context may already be destroyed
+		// when the counter gets destroyed
+		std::vector<GLuint> mFreeQueries;
+		// The queries that have ended, in the order they ended
+		std::deque<GLuint> mEndedQueries;
+		GLuint mActiveQuery = 0;
+	};
+
+	// Counts the results of a "GpuQueryCounter" during its lifetime
+	class GpuQueryScope
+	{
+	public:
+		GpuQueryScope(GpuQueryCounter& queryCounter)
+			:
+			mQueryCounter(queryCounter)
+		{
+			mQueryCounter.Begin();
+		}
+		~GpuQueryScope()
+		{
+			mQueryCounter.End();
+		}
+		// One should not be able to copy nor move a "GpuQueryScope" instance
+		GpuQueryScope(const GpuQueryScope& other) = delete;
+		GpuQueryScope& operator=(const GpuQueryScope& other) = delete;
+	private:
+		GpuQueryCounter& mQueryCounter;
+	};
+
+	// Measures the GPU time of the commands that are issued during its lifetime
+	class GpuTimer
+	{
+	public:
+		GpuTimer(const ScopeDescriptor& scope)
+			:
+			mScope(GpuProfiler::Get().Begin(scope))
+		{
+		}
+		~GpuTimer()
+		{
+			GpuProfiler::Get().End(mScope);
+		}
+		// One should not be able to copy nor move a "GpuTimer" instance
+		GpuTimer(const GpuTimer& other) = delete;
+		GpuTimer& operator=(const GpuTimer& other) = delete;
+	private:
+		GpuProfiler::Scope mScope;
+	};
+}
@@ -0,0 +1,71 @@
+#include "BenchmarkHistogram.h"
+#include <bit>
+#include <cmath>
+
+void benchmark::Histogram::Add(long long value)
+{
+	assert(value >= 0);
+
+	++mBuckets[GetBucketIndex((unsigned long long)value)];
+	++mCount;
+}
+
+long long benchmark::Histogram::GetPercentile(double percentile) const
+{
+	assert(percentile >= 0.0 && percentile <= 100.0);
+
+	if (mCount == 0)
+	{
+		return 0;
+	}
+
+	// The number of values that are smaller than or equal to the percentile
+	const unsigned long long rank = std::max(1ull, (unsigned long long)std::ceil(percentile / 100.0 * (double)mCount));
+
+	unsigned long long accumulatedCount = 0;
+	for (size_t i = 0; i < BUCKET_COUNT; i++)
+	{
+		accumulatedCount += mBuckets[i];
+		if (accumulatedCount >= rank)
+		{
+			return (long long)GetBucketUpperBound(i);
+		}
+	}
+
+	// Unreachable, since the buckets add up to "mCount"
+	assert(false);
+	return 0;
+}
+
+unsigned long long benchmark::Histogram::GetCount() const
+{
+	return mCount;
+}
+
+size_t benchmark::Histogram::GetBucketIndex(unsigned long long value)
+{
+	if (value < SUB_BUCKET_COUNT)
+	{
+		return (size_t)value;
+	}
+
+	// The position of the highest set bit. The "SUB_BUCKET_BITS" bits below it select the sub bucket.
+	const unsigned int exponent = (unsigned int)std::bit_width(value) - 1;
+	const size_t subBucket = (size_t)(value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+	return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + subBucket;
+}
+
+unsigned long long benchmark::Histogram::GetBucketUpperBound(size_t bucketIndex)
+{
+	if (bucketIndex < SUB_BUCKET_COUNT)
+	{
+		return bucketIndex;
+	}
+
+	const unsigned int exponent = (unsigned int)(bucketIndex / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS - 1;
+	const unsigned long long subBucket = bucketIndex % SUB_BUCKET_COUNT;
+	const unsigned int shift = exponent - SUB_BUCKET_BITS;
+	// Every bucket of the power of two is 2^shift values wide
+	const unsigned long long lowerBound = (SUB_BUCKET_COUNT + subBucket) << shift;
+	return lowerBound + ((1ull << shift) - 1);
+}
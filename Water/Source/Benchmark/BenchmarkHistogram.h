@@ -0,0 +1,33 @@
+#pragma once
+#include <array>
+
+namespace benchmark
+{
+	// A log-linear histogram in the style of HDR histograms. Every power of two is split into
+	// "SUB_BUCKET_COUNT" linear buckets, so the relative error of a recorded value is at most
+	// 1 / SUB_BUCKET_COUNT, regardless of whether the value is a nanosecond or an hour. 
+	// The memory usage is constant, no matter how many values get recorded.
+	class Histogram
+	{
+	public:
+		// "value" needs to be non-negative
+		void Add(long long value);
+		// "percentile" needs to be in the range [0, 100]. Returns the upper bound of
+		// the bucket that contains the percentile, or 0 if no values have been added.
+		long long GetPercentile(double percentile) const;
+		unsigned long long GetCount() const;
+	private:
+		static size_t GetBucketIndex(unsigned long long value);
+		// Returns the largest value that falls into the bucket
+		static unsigned long long GetBucketUpperBound(size_t bucketIndex);
+	private:
+		static constexpr unsigned int SUB_BUCKET_BITS = 5;
+		static constexpr size_t SUB_BUCKET_COUNT = (size_t)1 << SUB_BUCKET_BITS;
+		// Values below "SUB_BUCKET_COUNT" get a bucket each. Every following power of two, 
+		// up to 2^63, gets "SUB_BUCKET_COUNT" buckets.
+		static constexpr size_t BUCKET_COUNT = SUB_BUCKET_COUNT * (64 - SUB_BUCKET_BITS + 1);
+
+		std::array<unsigned long long, BUCKET_COUNT> mBuckets = {};
+		unsigned long long mCount = 0;
+	};
+}
@@ -2,26 +2,78 @@
 #include "BenchmarkTimer.h"
 #include "BenchmarkSession.h"
 #include "BenchmarkManager.h"
+#include "BenchmarkGpuProfiler.h"
+#include "BenchmarkCounter.h"
+#include "BenchmarkStandardCounters.h"
 
 // Enables/disables all the benchmarking
 #define ENABLE_BENCHMARKING 1
 #define ALLOW_BENCHMARK_SAVING 1
+// Either "Trace" for a timeline of every timing, or "Statistics" for aggregated statistics per scope
+#define BENCHMARK_MODE Trace
+// Frames that take longer than this are reported as hitches
+#define FRAME_BUDGET_MILLISECONDS 16.6
+// Replaces the global "operator new" and "operator delete", in order to count the heap bytes
+#define COUNT_HEAP_ALLOCATIONS 1
 
 #define CONCATENATE(a, b) CONCATENATE_I(a, b)
 #define CONCATENATE_I(a, b) CONCATENATE_II(~, a ## b)
 #define CONCATENATE_II(p, res) res
 
 #if ENABLE_BENCHMARKING
-// Enables benchmarking for the scope
-#define BENCHMARK benchmark::Timer CONCATENATE(timer, __LINE__)(__FUNCSIG__)
-#define NAMED_BENCHMARK(name) benchmark::Timer CONCATENATE(timer, __LINE__)(name)
+// Enables benchmarking for the scope. The scope descriptor is static, so the name
+// only gets registered the first time the scope is entered.
+#define BENCHMARK NAMED_BENCHMARK(__FUNCSIG__)
+#define NAMED_BENCHMARK(name) \
+static const benchmark::ScopeDescriptor CONCATENATE(scopeDescriptor, __LINE__)(name); \
+benchmark::Timer CONCATENATE(timer, __LINE__)(CONCATENATE(scopeDescriptor, __LINE__))
+
+// Enables benchmarking for the scope and marks it as a frame. There should only be one frame scope per frame.
+#define BENCHMARK_FRAME \
+static const benchmark::ScopeDescriptor CONCATENATE(scopeDescriptor, __LINE__)("Frame", benchmark::ScopeKind::Frame); \
+benchmark::Timer CONCATENATE(timer, __LINE__)(CONCATENATE(scopeDescriptor, __LINE__))
+// Enables benchmarking for the scope and adds its time to the given phase of the frame, e.g., "Update"
+#define BENCHMARK_FRAME_PHASE(phase) \
+static const benchmark::ScopeDescriptor CONCATENATE(scopeDescriptor, __LINE__)(benchmark::FramePhase::phase); \
+benchmark::Timer CONCATENATE(timer, __LINE__)(CONCATENATE(scopeDescriptor, __LINE__))
+
+// Enables benchmarking of the GPU commands that are issued inside the scope. 
+// Should only be used on the thread that owns the GL context.
+#define GPU_BENCHMARK(name) \
+static const benchmark::ScopeDescriptor CONCATENATE(scopeDescriptor, __LINE__)(name); \
+benchmark::GpuTimer CONCATENATE(gpuTimer, __LINE__)(CONCATENATE(scopeDescriptor, __LINE__))
+// Counts the results of a GL query, e.g., "GL_TESS_EVALUATION_SHADER_INVOCATIONS", for the GPU commands
+// that are issued inside the scope. The results are published as a per-frame counter.
+#define GPU_BENCHMARK_COUNTER(name, target) \
+static benchmark::GpuQueryCounter CONCATENATE(gpuQueryCounter, __LINE__)(name, target); \
+benchmark::GpuQueryScope CONCATENATE(gpuQueryScope, __LINE__)(CONCATENATE(gpuQueryCounter, __LINE__))
+// Hands the GPU timings, whose results have become available, to the manager. Should get called once per frame.
+#define COLLECT_GPU_BENCHMARKS benchmark::GpuProfiler::Get().Collect()
+
+// Adds "value" to a counter that publishes its increase once per frame, e.g., the number of drawn objects
+#define BENCHMARK_COUNTER_ADD(name, value) \
+static benchmark::Counter CONCATENATE(counter, __LINE__)(name, benchmark::CounterKind::PerFrame); \
+CONCATENATE(counter, __LINE__).Add((double)(value))
+// Sets the value of a counter
+#define BENCHMARK_COUNTER_SET(name, value) \
+static benchmark::Counter CONCATENATE(counter, __LINE__)(name); \
+CONCATENATE(counter, __LINE__).Set((double)(value))
+// Samples all of the counters. Should get called once per frame.
+#define SAMPLE_BENCHMARK_COUNTERS benchmark::Manager::Get().SampleCounters()
+// Registers the counters for the heap bytes and the log rate
+#define REGISTER_STANDARD_BENCHMARK_COUNTERS benchmark::RegisterStandardCounters()
+
+// Selects "BENCHMARK_MODE". Should get called before the first session is created.
+#define SET_BENCHMARK_MODE benchmark::Manager::Get().SetMode(benchmark::Mode::BENCHMARK_MODE)
+// Selects "FRAME_BUDGET_MILLISECONDS"
+#define SET_FRAME_BUDGET benchmark::Manager::Get().SetFrameBudget(FRAME_BUDGET_MILLISECONDS)
 
 // Turns the current scope into a session
 #define CREATE_BENCHMARK_SESSION(name) benchmark::Session benchmarkSession(name)
 
 // Names the current thread
 #define NAME_THREAD(name) benchmark::Manager::Get().NameThread( \
-benchmark::data::Thread{name, (unsigned int)std::hash<std::thread::id>()(std::this_thread::get_id())})
+benchmark::data::Thread{name, benchmark::GetThreadId()})
 
 #if ALLOW_BENCHMARK_SAVING
 // Saves the benchmark file
@@ -32,7 +84,18 @@ benchmark::data::Thread{name, (unsigned int)std::hash<std::thread::id>()(std::th
 
 #else
 #define BENCHMARK
-#define NAMED_BENCHMARK
+#define NAMED_BENCHMARK(name)
+#define BENCHMARK_FRAME
+#define BENCHMARK_FRAME_PHASE(phase)
+#define GPU_BENCHMARK(name)
+#define GPU_BENCHMARK_COUNTER(name, target)
+#define COLLECT_GPU_BENCHMARKS
+#define BENCHMARK_COUNTER_ADD(name, value)
+#define BENCHMARK_COUNTER_SET(name, value)
+#define SAMPLE_BENCHMARK_COUNTERS
+#define REGISTER_STANDARD_BENCHMARK_COUNTERS
+#define SET_BENCHMARK_MODE
+#define SET_FRAME_BUDGET
 #define CREATE_BENCHMARK_SESSION(name)
 #define NAME_THREAD(name)
 #define SAVE_BENCHMARK
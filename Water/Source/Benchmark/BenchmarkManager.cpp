@@ -1,15 +1,34 @@
 #include "BenchmarkManager.h"
-#include "BenchmarkEventFactory.h"
+#include "BenchmarkTscClock.h"
 #include "../CustomException.h"
 #include "../Console/ErrorLog.h"
 #include "../Console/Log.h"
 #include "../Console/ConsoleInput.h"
+#include <filesystem>
 benchmark::Manager::Manager()
 {
 	// Make the file stream throw exceptions
 	mFile.exceptions(std::ios::badbit | std::ios::failbit);
 	OpenFile();
-	mFile << "[";
+
+	// Serialize the benchmarks on a separate thread, so that the benchmarked threads
+	// never have to wait for the file
+	mDrainer = std::thread(&Manager::DrainLoop, this);
+}
+
+benchmark::Manager::~Manager()
+{
+	{
+		std::lock_guard lockGuard(mMutex);
+		mShouldStopDraining = true;
+	}
+	mDrainCondition.notify_one();
+	mDrainer.join();
+
+	// Write the timings that were recorded after the last drain
+	std::lock_guard lockGuard(mMutex);
+	Drain();
+	FlushTrace();
 }
 
 benchmark::Manager& benchmark::Manager::Get()
@@ -20,6 +39,11 @@ benchmark::Manager& benchmark::Manager::Get()
 
 void benchmark::Manager::BeginSession(const std::string& processName)
 {
+	// The rate of the timestamp counter is measured once per session, since 
+	// it is cheap compared to a session and keeps up with long running processes.
+	// It sleeps while measuring, so it is done before the other threads get locked out.
+	TscClock::Calibrate();
+
 	std::lock_guard lockGuard(mMutex);
 
 	assert(!SessionIsActive());
@@ -43,18 +67,34 @@ void benchmark::Manager::EndSession()
 
 	assert(SessionIsActive());
 
+	// The timings that are still inside the thread buffers belong to the ending session
+	Drain();
+	FlushTrace();
+
+	// Report the timings that were dropped during the session
+	const size_t droppedTimings = GetDroppedTimingCount();
+	if (droppedTimings != mReportedDroppedTimings)
+	{
+		ERROR_LOG("Dropped " << droppedTimings - mReportedDroppedTimings << " timings, since the benchmarked threads "
+				  "recorded them faster than they could be written");
+		mReportedDroppedTimings = droppedTimings;
+	}
+
 	mSessionData.isActive = false;
 }
 
 void benchmark::Manager::Benchmark(const data::Timing& timingData)
 {
-	std::lock_guard lockGuard(mMutex);
+	assert(SessionIsActive());
+
+	Push(timingData);
+}
 
+void benchmark::Manager::Benchmark(const data::Counter& counterData)
+{
 	assert(SessionIsActive());
 
-	ProcessEvent(
-		EventFactory::CreateTiming(timingData, mSessionData.activeId)
-	);
+	Push(counterData);
 }
 
 void benchmark::Manager::NameThread(const data::Thread& threadData)
@@ -67,9 +107,7 @@ void benchmark::Manager::NameThread(const data::Thread& threadData)
 		// This thread has not yet been named
 
 		mThreadIdToName[threadData.threadId] = threadData.name;
-		ProcessEvent(
-			EventFactory::CreateThread(threadData, mSessionData.activeId)
-		);
+		mTraceWriter.WriteThread(threadData, mSessionData.activeId);
 	}
 	else
 	{
@@ -79,6 +117,47 @@ void benchmark::Manager::NameThread(const data::Thread& threadData)
 
 }
 
+unsigned int benchmark::Manager::RegisterScope(const ScopeDescriptor& scope)
+{
+	std::lock_guard lockGuard(mScopesMutex);
+
+	mScopes.push_back(ScopeInfo{ scope.name, scope.kind, scope.phase });
+	return (unsigned int)mScopes.size() - 1;
+}
+
+void benchmark::Manager::RegisterCounter(Counter& counter)
+{
+	std::lock_guard lockGuard(mCountersMutex);
+	mCounters.push_back(&counter);
+}
+
+void benchmark::Manager::UnregisterCounter(Counter& counter)
+{
+	std::lock_guard lockGuard(mCountersMutex);
+	mCounters.erase(std::remove(mCounters.begin(), mCounters.end(), &counter), mCounters.end());
+}
+
+void benchmark::Manager::SampleCounters()
+{
+	if (!SessionIsActive())
+	{
+		return;
+	}
+
+	std::lock_guard lockGuard(mCountersMutex);
+
+	const long long timepoint = TscClock::now().time_since_epoch().count();
+	// The very first sample has no previous sample to compare against
+	const double secondsSinceLastSample = 
+		mPreviousCounterSample == 0 ? 0.0 : (double)(timepoint - mPreviousCounterSample) / 1e+9;
+	mPreviousCounterSample = timepoint;
+
+	for (Counter* counter : mCounters)
+	{
+		Push(data::Counter(counter->GetId(), timepoint, counter->Sample(secondsSinceLastSample)));
+	}
+}
+
 void benchmark::Manager::SaveBenchmark()
 {
 	try
@@ -87,30 +166,34 @@ void benchmark::Manager::SaveBenchmark()
 		{
 			return;
 		}
-		// Make sure that this is the only thread that logs or uses "CIN" during the duration of this scope.
-		// We do not want the output, "LOG", to get detached from the input, "CIN".
-		std::scoped_lock scopedLock(gLogMutex, gConsoleInputMutex);
 
-		LOG("Save benchmark as: ");
 		std::string name;
-		CIN(name);
-
-		const long long length = mFile.tellp();
-		auto buffer = std::make_unique<char[]>(length);
+		{
+			// Make sure that this is the only thread that logs or uses "CIN" during the duration of this scope.
+			// We do not want the output, "LOG", to get detached from the input, "CIN".
+			std::scoped_lock scopedLock(gLogMutex, gConsoleInputMutex);
 
-		// Read the whole file into "buffer"
-		mFile.seekg(std::ios::beg);
-		mFile.read(buffer.get(), length);
-		mFile.seekg(std::ios::end);
+			LOG("Save benchmark as: ");
+			CIN(name);
+		}
 
-		std::ofstream saveFile; 
-		// Make the file stream throw exceptions
-		saveFile.exceptions(std::ios::badbit | std::ios::failbit);
+		// Make sure that all of the timings recorded so far get saved
+		std::lock_guard lockGuard(mMutex);
+		Drain();
 
-		saveFile.open(SAVE_FILE_PATH + name + ".json");
+		if (mMode == Mode::Trace)
+		{
+			SaveTrace(name);
+		}
+		else
+		{
+			SaveStatistics(name);
+		}
 
-		// Copy the current benchmarking content into the save file
-		saveFile.write(buffer.get(), length);
+		if (mFrameStatistics.GetFrameCount() > 0)
+		{
+			SaveFrameReport(name);
+		}
 	}
 	catch (const std::exception& exception)
 	{
@@ -118,6 +201,144 @@ void benchmark::Manager::SaveBenchmark()
 	}
 }
 
+void benchmark::Manager::SetMode(Mode mode)
+{
+	std::lock_guard lockGuard(mMutex);
+
+	assert(!SessionIsActive());
+
+	// The timings that are still inside the thread buffers were recorded in the previous mode
+	Drain();
+	mMode = mode;
+}
+
+void benchmark::Manager::SetFrameBudget(double milliseconds)
+{
+	std::lock_guard lockGuard(mMutex);
+	mFrameStatistics.SetBudget((long long)(milliseconds * 1e+6));
+}
+
+size_t benchmark::Manager::GetDroppedTimingCount() const
+{
+	return mDroppedTimings.load(std::memory_order_relaxed);
+}
+
+void benchmark::Manager::Push(const Record& record)
+{
+	ThreadBuffer* threadBuffer = GetThreadBuffer();
+	if (!threadBuffer || !threadBuffer->TryPush(record))
+	{
+		// Waiting for the writer thread would distort the timings of the benchmarked thread,
+		// so we drop the record instead
+		mDroppedTimings.fetch_add(1, std::memory_order_relaxed);
+		mDrainCondition.notify_one();
+	}
+}
+
+benchmark::Manager::ThreadBuffer* benchmark::Manager::GetThreadBuffer()
+{
+	// Every thread caches a pointer to its own buffer, so that only the
+	// first call on each thread has to lock a mutex
+	thread_local ThreadBuffer* threadBuffer = nullptr;
+	thread_local bool hasRequestedBuffer = false;
+	if (!hasRequestedBuffer)
+	{
+		hasRequestedBuffer = true;
+
+		std::lock_guard lockGuard(mThreadBuffersMutex);
+		const size_t usedMemory = WRITE_BUFFER_SIZE + mThreadBuffers.size() * sizeof(ThreadBuffer);
+		if (usedMemory + sizeof(ThreadBuffer) <= MEMORY_CAP)
+		{
+			threadBuffer = mThreadBuffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+		}
+		else
+		{
+			ERROR_LOG("The benchmark memory cap has been reached. The timings of this thread will be dropped.");
+		}
+	}
+	return threadBuffer;
+}
+
+void benchmark::Manager::DrainLoop()
+{
+	std::unique_lock uniqueLock(mMutex);
+	while (!mShouldStopDraining)
+	{
+		mDrainCondition.wait_for(uniqueLock, DRAIN_INTERVAL);
+		Drain();
+	}
+}
+
+void benchmark::Manager::Drain()
+{
+	std::scoped_lock scopedLock(mThreadBuffersMutex, mScopesMutex);
+
+	Record record;
+	for (auto& threadBuffer : mThreadBuffers)
+	{
+		while (threadBuffer->TryPop(record))
+		{
+			if (const auto* timingData = std::get_if<data::Timing>(&record))
+			{
+				ProcessTiming(*timingData);
+			}
+			else
+			{
+				ProcessCounter(std::get<data::Counter>(record));
+			}
+		}
+	}
+
+	// Write in large chunks, instead of once per drain
+	if (mTraceWriter.GetBufferSize() >= WRITE_BUFFER_SIZE)
+	{
+		FlushTrace();
+	}
+}
+
+void benchmark::Manager::ProcessTiming(const data::Timing& timingData)
+{
+	const ScopeInfo& scope = mScopes[timingData.scopeId];
+
+	if (scope.kind == ScopeKind::FramePhase)
+	{
+		mFrameStatistics.AddPhase(timingData, scope.phase);
+	}
+
+	if (mMode == Mode::Statistics)
+	{
+		mStatistics.Add(timingData);
+
+		if (scope.kind == ScopeKind::Frame)
+		{
+			mFrameStatistics.AddFrame(timingData);
+		}
+	}
+	else if (scope.kind == ScopeKind::Frame)
+	{
+		// The frame record replaces the timing of the frame scope
+		mTraceWriter.WriteFrame(mFrameStatistics.AddFrame(timingData), mSessionData.activeId);
+	}
+	else
+	{
+		mTraceWriter.WriteTiming(timingData, scope.name.c_str(), mSessionData.activeId);
+	}
+}
+
+void benchmark::Manager::ProcessCounter(const data::Counter& counterData)
+{
+	const ScopeInfo& counter = mScopes[counterData.counterId];
+
+	if (mMode == Mode::Statistics)
+	{
+		mStatistics.AddCounter(counterData);
+	}
+	else
+	{
+		mTraceWriter.WriteCounter(counterData, counter.name.c_str(), mSessionData.activeId);
+	}
+}
+
 bool benchmark::Manager::SessionIsActive() const
 {
 	return mSessionData.isActive;
@@ -125,21 +346,66 @@ bool benchmark::Manager::SessionIsActive() const
 
 void benchmark::Manager::CreateSession(const std::string& processName)
 {
-	ProcessEvent(
-		EventFactory::CreateSession(benchmark::data::Session{ processName }, mSessionData.nextId)
-	);
+	mTraceWriter.WriteSession(benchmark::data::Session{ processName }, mSessionData.nextId);
 	mSessionData.nameToId[processName] = mSessionData.nextId++;
 }
 
-void benchmark::Manager::ProcessEvent(const benchmark::Event& event)
+void benchmark::Manager::SaveTrace(const std::string& name)
+{
+	FlushTrace();
+
+	// Let the file system copy the file, instead of reading the whole trace into memory.
+	// The writer thread can not append to the file in the meantime, since we hold "mMutex".
+	std::filesystem::copy_file(FILE_PATH, SAVE_FILE_PATH + name + ".bin",
+							   std::filesystem::copy_options::overwrite_existing);
+}
+
+void benchmark::Manager::SaveStatistics(const std::string& name)
+{
+	std::vector<std::string> scopeNames;
+	{
+		std::lock_guard lockGuard(mScopesMutex);
+		for (const ScopeInfo& scope : mScopes)
+		{
+			scopeNames.push_back(scope.name);
+		}
+	}
+	const std::string table = mStatistics.CreateTable(scopeNames);
+
+	LOG(std::endl << table);
+
+	std::ofstream saveFile;
+	// Make the file stream throw exceptions
+	saveFile.exceptions(std::ios::badbit | std::ios::failbit);
+
+	saveFile.open(SAVE_FILE_PATH + name + ".txt");
+	saveFile << table;
+}
+
+void benchmark::Manager::SaveFrameReport(const std::string& name)
+{
+	const std::string report = mFrameStatistics.CreateReport();
+
+	LOG(std::endl << report);
+
+	std::ofstream saveFile;
+	// Make the file stream throw exceptions
+	saveFile.exceptions(std::ios::badbit | std::ios::failbit);
+
+	saveFile.open(SAVE_FILE_PATH + name + ".frames.txt");
+	saveFile << report;
+}
+
+void benchmark::Manager::FlushTrace()
 {
 	try
 	{
-		mFile << event.GetData() + "," << std::endl;
+		mTraceWriter.Flush(mFile);
+		mFile.flush();
 	}
 	catch (std::ios_base::failure)
 	{
-		ERROR_LOG("Failed to process event. Re-opening file");
+		ERROR_LOG("Failed to write the trace. Re-opening file");
 		ReopenFile();
 	}
 }
@@ -148,10 +414,8 @@ void benchmark::Manager::OpenFile()
 {
 	try
 	{ 
-		// Open the file for both reading and writing. 
 		// We want to discard the old content, hence "std::ios_base::trunc"
-		mFile.open(FILE_PATH, std::ios_base::in | std::ios_base::out | 
-							  std::ios_base::trunc | std::ios::binary);
+		mFile.open(FILE_PATH, std::ios_base::out | std::ios_base::trunc | std::ios::binary);
 	}
 	catch (std::ios_base::failure)
 	{
@@ -172,6 +436,8 @@ void benchmark::Manager::ReopenFile()
 	}
 
 	OpenFile();
+	// The new file needs its own header and can not refer to names that were interned inside the old file
+	mTraceWriter.Reset();
 }
 
 bool benchmark::Manager::UserWantsToSave() const
@@ -1,17 +1,35 @@
 #pragma once
 #include <fstream>
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
 #include "Data/All.h"
-#include "BenchmarkEvent.h"
+#include "BenchmarkTraceWriter.h"
+#include "BenchmarkRingBuffer.h"
+#include "BenchmarkStatistics.h"
+#include "BenchmarkFrameStatistics.h"
+#include "BenchmarkScope.h"
+#include "BenchmarkCounter.h"
+#include <variant>
 
 namespace benchmark
-{ 
+{
 	struct SessionData
 	{
 		std::unordered_map<std::string, int> nameToId;
-		bool isActive = false;
+		// Atomic, since it gets asserted on by every benchmarked thread
+		std::atomic<bool> isActive = false;
 		int activeId = 0;
-		int nextId = 0; 
+		int nextId = 0;
+	};
+	enum class Mode
+	{
+		// Records every timing into a trace, which can be converted for "chrome://tracing"
+		Trace,
+		// Only keeps aggregated statistics per scope, which are written when the benchmark is saved.
+		// Barely uses any storage, which makes it suitable for long runs.
+		Statistics
 	};
 	// Singleton
 	class Manager
@@ -19,30 +37,121 @@ namespace benchmark
 	public:
 		// Thread-safe
 		static Manager& Get();
+		~Manager();
 		// Thread-safe
 		void BeginSession(const std::string& processName);
 		// Thread-safe
 		void EndSession();
-		// Thread-safe
+		// Thread-safe and lock-free, except for the very first call on each thread.
+		// Never waits for the writer thread: if the thread's buffer is full, the timing gets dropped.
 		void Benchmark(const data::Timing& timingData);
+		// Same as above, but for a sample of a counter
+		void Benchmark(const data::Counter& counterData);
 		// Thread-safe
 		void NameThread(const data::Thread& threadData);
+		// Thread-safe. Returns the id that the timings of the scope refer to.
+		unsigned int RegisterScope(const ScopeDescriptor& scope);
+		// Thread-safe. "counter" gets sampled by SampleCounters() until it gets unregistered.
+		void RegisterCounter(Counter& counter);
+		void UnregisterCounter(Counter& counter);
+		// Thread-safe. Samples all of the registered counters. Should get called once per frame.
+		void SampleCounters();
 
 		void SaveBenchmark();
+		// Thread-safe. Should not get called while a session is active.
+		void SetMode(Mode mode);
+		// Thread-safe. Frames that take longer than "milliseconds" are reported as hitches.
+		void SetFrameBudget(double milliseconds);
+		// Thread-safe. The number of timings that have been dropped, since their thread's buffer was full.
+		size_t GetDroppedTimingCount() const;
 	private:
+		// The number of timings that every thread can record before the writer thread has to empty its buffer
+		static constexpr size_t THREAD_BUFFER_SIZE = 8192;
+		// The encoded trace is collected in memory and only written into the file once it reaches this size
+		static constexpr size_t WRITE_BUFFER_SIZE = 4 * 1024 * 1024;
+		// The upper bound for the memory of the thread buffers and the write buffer combined. 
+		// Threads that would exceed the cap do not get a buffer and all of their timings are dropped.
+		static constexpr size_t MEMORY_CAP = 64 * 1024 * 1024;
+		// How often the writer thread empties the thread buffers, unless a full buffer wakes it up earlier
+		static constexpr std::chrono::milliseconds DRAIN_INTERVAL{ 10 };
+
+		// Every benchmarked thread records its timings and counter samples into its own buffer
+		using Record = std::variant<data::Timing, data::Counter>;
+		using ThreadBuffer = RingBuffer<Record, THREAD_BUFFER_SIZE>;
+		// The part of a "ScopeDescriptor" that the manager needs after the registration
+		struct ScopeInfo
+		{
+			std::string name;
+			ScopeKind kind = ScopeKind::Scope;
+			FramePhase phase = FramePhase::Count;
+		};
+
 		Manager();
+		static_assert(WRITE_BUFFER_SIZE + sizeof(ThreadBuffer) <= MEMORY_CAP, 
+					  "The memory cap has to fit the write buffer and at least one thread buffer");
+
+		// Returns the buffer of the calling thread. The buffer gets created the first time
+		// a thread calls this method. Returns nullptr if the buffer would exceed "MEMORY_CAP".
+		ThreadBuffer* GetThreadBuffer();
+		// Runs on "mDrainer"
+		void DrainLoop();
+		// Empties all of the thread buffers into the trace and writes the trace into the file
+		// once "WRITE_BUFFER_SIZE" is reached. "mMutex" needs to be locked by the caller.
+		void Drain();
 		void CreateSession(const std::string & processName);
-		void ProcessEvent(const Event& event);
+		void SaveTrace(const std::string& name);
+		void SaveStatistics(const std::string& name);
+		void SaveFrameReport(const std::string& name);
+		// Pushes "record" into the buffer of the calling thread
+		void Push(const Record& record);
+		// Routes a drained timing depending on "mMode" and the kind of its scope
+		void ProcessTiming(const data::Timing& timingData);
+		void ProcessCounter(const data::Counter& counterData);
+		// Writes the buffered trace into the file. "mMutex" needs to be locked by the caller.
+		void FlushTrace();
 		bool SessionIsActive() const;
 		void OpenFile();
 		void ReopenFile();
 		bool UserWantsToSave() const;
 	private:
-		std::fstream mFile;
+		std::ofstream mFile;
+		Mode mMode = Mode::Trace;
+		// Encodes the events into the binary trace format
+		TraceWriter mTraceWriter;
+		// Only used in "Mode::Statistics"
+		Statistics mStatistics;
+		// Used in both modes
+		FrameStatistics mFrameStatistics;
 		std::mutex mMutex;
 		std::unordered_map<int, std::string> mThreadIdToName;
 		SessionData mSessionData;
-		inline static const std::string FILE_PATH = "../Benchmarks/Benchmark.json";
+
+		// The buffers are owned by the manager and not by their threads, since a thread could
+		// exit before the drainer has emptied its buffer
+		std::vector<std::unique_ptr<ThreadBuffer>> mThreadBuffers;
+		// Only guards "mThreadBuffers", so that a new thread does not have to wait for a drain to finish
+		std::mutex mThreadBuffersMutex;
+
+		// The registered scopes, indexed by scope id
+		std::vector<ScopeInfo> mScopes;
+		// Only guards "mScopes", so that registering a scope does not have to wait for a drain to finish
+		std::mutex mScopesMutex;
+
+		std::vector<Counter*> mCounters;
+		std::mutex mCountersMutex;
+		// When the counters were sampled the last time, in nanoseconds
+		long long mPreviousCounterSample = 0;
+
+		std::thread mDrainer;
+		std::condition_variable mDrainCondition;
+		bool mShouldStopDraining = false;
+
+		// Incremented by the benchmarked threads, whenever they have to drop a timing
+		std::atomic<size_t> mDroppedTimings = 0;
+		// The number of dropped timings that have already been reported
+		size_t mReportedDroppedTimings = 0;
+
+		inline static const std::string FILE_PATH = "../Benchmarks/Benchmark.bin";
 		inline static const std::string SAVE_FILE_PATH = "../Benchmarks/Saved/";
 	};
-}
\ No newline at end of file
+}
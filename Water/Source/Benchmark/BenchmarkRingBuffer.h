@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include "../CustomConcepts.h"
+
+namespace benchmark
+{
+	// A lock-free ring buffer with exactly one producer and one consumer. 
+	// Every benchmarked thread owns one of these buffers and is its only producer,
+	// while the drainer thread of "Manager" is its only consumer.
+	template<class T, size_t N>
+	// N needs to be a power of two, since we need to use the &-operator instead
+	// of the %-operator
+	requires(IsPowerOfTwo(N))
+	class RingBuffer
+	{
+	public:
+		RingBuffer() = default;
+		// One should not be able to copy nor move a "RingBuffer" instance, since
+		// another thread could be accessing it
+		RingBuffer(const RingBuffer& other) = delete;
+		RingBuffer& operator=(const RingBuffer& other) = delete;
+
+		// Should only get called by the producer. Returns false if the buffer is full.
+		bool TryPush(const T& value)
+		{
+			const size_t head = mHead.load(std::memory_order_relaxed);
+			// The buffer is full if the producer is an entire lap ahead of the consumer
+			if (head - mTail.load(std::memory_order_acquire) == N)
+			{
+				return false;
+			}
+
+			mSlots[head & (N - 1)] = value;
+			// Publish the written slot to the consumer
+			mHead.store(head + 1, std::memory_order_release);
+			return true;
+		}
+		// Should only get called by the consumer. Returns false if the buffer is empty.
+		bool TryPop(T& value)
+		{
+			const size_t tail = mTail.load(std::memory_order_relaxed);
+			if (tail == mHead.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+
+			value = std::move(mSlots[tail & (N - 1)]);
+			// Hand the read slot back to the producer
+			mTail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+	private:
+		// The head and the tail are written by different threads. We place them on separate
+		// cache lines, so that the producer and the consumer do not keep invalidating each
+		// other's cache line.
+		alignas(64) std::atomic<size_t> mHead = 0;
+		alignas(64) std::atomic<size_t> mTail = 0;
+		T mSlots[N];
+	};
+}
@@ -0,0 +1,21 @@
+#include "BenchmarkScope.h"
+#include "BenchmarkManager.h"
+
+benchmark::ScopeDescriptor::ScopeDescriptor(const char* name, ScopeKind kind)
+	:
+	name(name),
+	kind(kind),
+	id(Manager::Get().RegisterScope(*this))
+{
+	// Frame phases need to know which phase they are
+	assert(kind != ScopeKind::FramePhase);
+}
+
+benchmark::ScopeDescriptor::ScopeDescriptor(FramePhase phase)
+	:
+	name(GetFramePhaseName(phase)),
+	kind(ScopeKind::FramePhase),
+	phase(phase),
+	id(Manager::Get().RegisterScope(*this))
+{
+}
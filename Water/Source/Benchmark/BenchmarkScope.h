@@ -0,0 +1,38 @@
+#pragma once
+#include "BenchmarkFramePhase.h"
+
+namespace benchmark
+{
+	enum class ScopeKind
+	{
+		// An ordinary scope
+		Scope,
+		// Encloses an entire frame
+		Frame,
+		// Encloses one of the phases of a frame
+		FramePhase,
+		// Not a scope, but a numeric series that gets sampled, see "Counter"
+		Counter
+	};
+
+	// Describes a benchmarked scope. "BENCHMARK" and "NAMED_BENCHMARK" create one static
+	// instance per call site, so the name only gets registered once and the timers
+	// only have to carry the id.
+	struct ScopeDescriptor
+	{
+		// "name" only has to outlive the constructor, since the manager copies it
+		ScopeDescriptor(const char* name, ScopeKind kind = ScopeKind::Scope);
+		// Describes a scope of the kind "ScopeKind::FramePhase"
+		ScopeDescriptor(FramePhase phase);
+		// One should not be able to copy nor move a "ScopeDescriptor" instance, 
+		// since that would make two descriptors share the same id
+		ScopeDescriptor(const ScopeDescriptor& other) = delete;
+		ScopeDescriptor& operator=(const ScopeDescriptor& other) = delete;
+
+		const char* const name;
+		const ScopeKind kind;
+		// Only meaningful for "ScopeKind::FramePhase"
+		const FramePhase phase = FramePhase::Count;
+		const unsigned int id;
+	};
+}
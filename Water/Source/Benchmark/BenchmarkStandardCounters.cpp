@@ -0,0 +1,62 @@
+#include "BenchmarkStandardCounters.h"
+#include "BenchmarkMacros.h"
+#include "BenchmarkCounter.h"
+#include "../Console/LogMutex.h"
+#include "../Mathematics/Vector/Vector.h"
+#include <new>
+#include <cstdlib>
+
+namespace
+{
+	std::atomic<long long> gHeapBytes = 0;
+}
+
+#if ENABLE_BENCHMARKING && COUNT_HEAP_ALLOCATIONS
+// Every allocation is prefixed with its size, so that "operator delete" knows how many bytes it
+// frees. The prefix is as large as the alignment that "operator new" guarantees, which is larger than
+// "alignof(std::max_align_t)" on MSVC, in order to keep the allocation aligned. The over-aligned
+// overloads of "operator new" are not replaced and therefore not counted.
+namespace
+{
+	constexpr size_t HEAP_PREFIX_SIZE = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+	// The vectors are loaded with aligned SSE instructions, also when they live on the heap
+	static_assert(HEAP_PREFIX_SIZE >= alignof(Vector4), "The counted allocations would misalign the vectors");
+}
+
+void* operator new(size_t size)
+{
+	char* const allocation = (char*)std::malloc(size + HEAP_PREFIX_SIZE);
+	if (!allocation)
+	{
+		throw std::bad_alloc();
+	}
+
+	*(size_t*)allocation = size;
+	gHeapBytes.fetch_add((long long)size, std::memory_order_relaxed);
+	return allocation + HEAP_PREFIX_SIZE;
+}
+
+void operator delete(void* pointer) noexcept
+{
+	if (!pointer)
+	{
+		return;
+	}
+
+	char* const allocation = (char*)pointer - HEAP_PREFIX_SIZE;
+	gHeapBytes.fetch_sub((long long)*(size_t*)allocation, std::memory_order_relaxed);
+	std::free(allocation);
+}
+#endif
+
+long long benchmark::GetHeapBytes()
+{
+	return gHeapBytes.load(std::memory_order_relaxed);
+}
+
+void benchmark::RegisterStandardCounters()
+{
+	// Function-local statics, so that the counters get created after, and destroyed before, "Manager"
+	static Counter heapBytes("Heap bytes", []() { return (double)GetHeapBytes(); });
+	static Counter logRate("Log messages per second", []() { return (double)gLogCount.load(); }, CounterKind::PerSecond);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace benchmark
+{
+	// The number of bytes that are currently allocated through the global "operator new". 
+	// Always 0, unless "COUNT_HEAP_ALLOCATIONS" is enabled.
+	long long GetHeapBytes();
+	// Registers the counters that are useful for every process, i.e., the heap bytes and
+	// the logged messages per second. Thread-safe. Only the first call has an effect.
+	void RegisterStandardCounters();
+}
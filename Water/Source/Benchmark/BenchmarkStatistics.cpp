@@ -0,0 +1,125 @@
+#include "BenchmarkStatistics.h"
+#include <sstream>
+#include <iomanip>
+
+void benchmark::Statistics::Add(const data::Timing& data)
+{
+	if (data.scopeId >= mScopeStatistics.size())
+	{
+		mScopeStatistics.resize(data.scopeId + 1);
+	}
+	auto& scopeStatistics = mScopeStatistics[data.scopeId];
+	if (!scopeStatistics)
+	{
+		scopeStatistics = std::make_unique<ScopeStatistics>();
+	}
+
+	std::deque<Span>& spans = mThreadIdToSpans[data.threadId];
+	const long long childTime = PopChildTime(spans, data);
+
+	// Recursive scopes are counted once per call, so their total time can exceed the wall time
+	scopeStatistics->count++;
+	scopeStatistics->totalTime += data.duration;
+	scopeStatistics->selfTime += std::max(0ll, data.duration - childTime);
+	scopeStatistics->minTime = std::min(scopeStatistics->minTime, data.duration);
+	scopeStatistics->maxTime = std::max(scopeStatistics->maxTime, data.duration);
+	scopeStatistics->histogram.Add(data.duration);
+
+	// The scope may be the child of a scope that has not yet ended
+	spans.push_back(Span{ data.timepoint, data.duration });
+	if (spans.size() > MAX_SPAN_COUNT)
+	{
+		// The oldest span is most likely a top level scope. If not, its time gets
+		// counted as the self time of its parent.
+		spans.pop_front();
+	}
+}
+
+void benchmark::Statistics::AddCounter(const data::Counter& data)
+{
+	CounterStatistics& statistics = mCounterStatistics[data.counterId];
+	statistics.count++;
+	statistics.sum += data.value;
+	statistics.min = std::min(statistics.min, data.value);
+	statistics.max = std::max(statistics.max, data.value);
+	statistics.last = data.value;
+}
+
+std::string benchmark::Statistics::CreateTable(const std::vector<std::string>& scopeNames) const
+{
+	std::vector<unsigned int> scopeIds;
+	for (unsigned int i = 0; i < mScopeStatistics.size(); i++)
+	{
+		if (mScopeStatistics[i])
+		{
+			scopeIds.push_back(i);
+		}
+	}
+	std::sort(scopeIds.begin(), scopeIds.end(), [this](unsigned int a, unsigned int b)
+		{
+			return mScopeStatistics[a]->selfTime > mScopeStatistics[b]->selfTime;
+		});
+
+	auto toMilliseconds = [](long long nanoseconds) { return (double)nanoseconds / 1e+6; };
+	auto toMicroseconds = [](long long nanoseconds) { return (double)nanoseconds / 1e+3; };
+
+	std::ostringstream table;
+	table << std::fixed << std::setprecision(3)
+		<< std::setw(12) << "Calls" << std::setw(14) << "Total (ms)" << std::setw(14) << "Self (ms)"
+		<< std::setw(12) << "Min (us)" << std::setw(12) << "p50 (us)" << std::setw(12) << "p95 (us)"
+		<< std::setw(12) << "p99 (us)" << std::setw(12) << "Max (us)" << "  Name" << std::endl;
+
+	for (const unsigned int scopeId : scopeIds)
+	{
+		const ScopeStatistics& statistics = *mScopeStatistics[scopeId];
+		// The histogram only knows which bucket a value fell into, so the percentiles are clamped to the known range
+		auto getPercentile = [&statistics](double percentile)
+		{
+			return std::clamp(statistics.histogram.GetPercentile(percentile), statistics.minTime, statistics.maxTime);
+		};
+
+		table 
+			<< std::setw(12) << statistics.count 
+			<< std::setw(14) << toMilliseconds(statistics.totalTime) 
+			<< std::setw(14) << toMilliseconds(statistics.selfTime)
+			<< std::setw(12) << toMicroseconds(statistics.minTime) 
+			<< std::setw(12) << toMicroseconds(getPercentile(50.0))
+			<< std::setw(12) << toMicroseconds(getPercentile(95.0)) 
+			<< std::setw(12) << toMicroseconds(getPercentile(99.0))
+			<< std::setw(12) << toMicroseconds(statistics.maxTime) 
+			<< "  " << scopeNames[scopeId] << std::endl;
+	}
+
+	if (!mCounterStatistics.empty())
+	{
+		table << std::endl
+			<< std::setw(12) << "Samples" << std::setw(16) << "Min" << std::setw(16) << "Average"
+			<< std::setw(16) << "Max" << std::setw(16) << "Last" << "  Counter" << std::endl;
+
+		for (const auto& [counterId, statistics] : mCounterStatistics)
+		{
+			table
+				<< std::setw(12) << statistics.count
+				<< std::setw(16) << statistics.min
+				<< std::setw(16) << statistics.sum / (double)statistics.count
+				<< std::setw(16) << statistics.max
+				<< std::setw(16) << statistics.last
+				<< "  " << scopeNames[counterId] << std::endl;
+		}
+	}
+
+	return table.str();
+}
+
+long long benchmark::Statistics::PopChildTime(std::deque<Span>& spans, const data::Timing& data)
+{
+	long long childTime = 0;
+	// The children ended before "data" did, so they are on the top of the stack. 
+	// A span that starts before "data" belongs to a previous scope.
+	while (!spans.empty() && spans.back().start >= data.timepoint)
+	{
+		childTime += spans.back().duration;
+		spans.pop_back();
+	}
+	return childTime;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <deque>
+#include <map>
+#include "Data/All.h"
+#include "BenchmarkHistogram.h"
+
+namespace benchmark
+{
+	// Aggregates the timings of every scope, instead of storing each timing. 
+	// The memory usage only depends on the number of scopes and threads.
+	class Statistics
+	{
+	public:
+		// The timings of a thread need to be added in the order they were recorded, 
+		// i.e., in the order the scopes ended
+		void Add(const data::Timing& data);
+		void AddCounter(const data::Counter& data);
+		// Creates a table with one row per scope, sorted by self time, followed by a table with one
+		// row per counter. "scopeNames" is indexed by scope id.
+		std::string CreateTable(const std::vector<std::string>& scopeNames) const;
+	private:
+		struct ScopeStatistics
+		{
+			unsigned long long count = 0;
+			long long totalTime = 0;
+			// The total time minus the time spent inside benchmarked child scopes
+			long long selfTime = 0;
+			long long minTime = std::numeric_limits<long long>::max();
+			long long maxTime = 0;
+			Histogram histogram;
+		};
+		struct CounterStatistics
+		{
+			unsigned long long count = 0;
+			double sum = 0.0;
+			double min = std::numeric_limits<double>::max();
+			double max = std::numeric_limits<double>::lowest();
+			double last = 0.0;
+		};
+		// The time span of a timing that has not yet been claimed by an enclosing timing
+		struct Span
+		{
+			long long start = 0;
+			long long duration = 0;
+		};
+	private:
+		// Removes the timings that are enclosed by "data" from the thread's stack and
+		// returns the time spent inside them
+		long long PopChildTime(std::deque<Span>& spans, const data::Timing& data);
+	private:
+		// The stack of each thread contains the spans that may still get an enclosing scope.
+		// Consecutive top level scopes are never claimed, so the stack has to be limited.
+		static constexpr size_t MAX_SPAN_COUNT = 1024;
+
+		// Indexed by scope id. Stored as pointers, since the histograms are large.
+		std::vector<std::unique_ptr<ScopeStatistics>> mScopeStatistics;
+		std::unordered_map<unsigned int, std::deque<Span>> mThreadIdToSpans;
+		// Sorted by counter id, so that the counters are listed in the order they were registered
+		std::map<unsigned int, CounterStatistics> mCounterStatistics;
+	};
+}
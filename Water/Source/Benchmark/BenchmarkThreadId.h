@@ -0,0 +1,14 @@
+#pragma once
+#include <thread>
+
+namespace benchmark
+{
+	// Returns the id of the calling thread as an unsigned int. The id gets
+	// hashed once per thread, instead of once per benchmarked scope.
+	inline unsigned int GetThreadId()
+	{
+		thread_local const unsigned int threadId = 
+			(unsigned int)std::hash<std::thread::id>()(std::this_thread::get_id());
+		return threadId;
+	}
+}
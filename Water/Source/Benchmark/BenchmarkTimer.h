@@ -1,7 +1,9 @@
 #pragma once
 #include <chrono>
 #include "BenchmarkManager.h"
-#include <thread>
+#include "BenchmarkScope.h"
+#include "BenchmarkThreadId.h"
+#include "BenchmarkTscClock.h"
 #include "../CustomConcepts.h"
 
 namespace benchmark
@@ -10,34 +12,35 @@ namespace benchmark
 	class BasicTimer
 	{
 	public:
-		BasicTimer(const std::string& name)
+		BasicTimer(const ScopeDescriptor& scope)
 			:
-			mName(name)
+			mScopeId(scope.id)
 		{
 			mStartTimePoint = C::now();
 		}
 		~BasicTimer()
 		{
+			const auto endTimePoint = C::now();
+
 			const auto startDuration = 
-				std::chrono::duration_cast<std::chrono::microseconds>(mStartTimePoint.time_since_epoch());
+				std::chrono::duration_cast<std::chrono::nanoseconds>(mStartTimePoint.time_since_epoch());
 			const auto endDuration = 
-				std::chrono::duration_cast<std::chrono::microseconds>(C::now().time_since_epoch());
+				std::chrono::duration_cast<std::chrono::nanoseconds>(endTimePoint.time_since_epoch());
 
 			const long long duration = (endDuration - startDuration).count();
 			const long long startTimepoint = startDuration.count();
 
-			// We hash the thread id in order to convert it to an unsigned int
-			const unsigned int hashedThreadId = (unsigned int)std::hash<std::thread::id>()(std::this_thread::get_id());
 			benchmark::Manager::Get().Benchmark(
-				benchmark::data::Timing{ mName, startTimepoint, duration, hashedThreadId });
+				benchmark::data::Timing{ mScopeId, startTimepoint, duration, GetThreadId() });
 		}
 		// One should not be able to copy nor move a "BasicTimer" instance
 		BasicTimer(const BasicTimer& other) = delete;
 		BasicTimer& operator=(const BasicTimer& other) = delete;
 	private:
 		typename C::time_point mStartTimePoint;
-		std::string mName;
+		unsigned int mScopeId;
 	};
 
-	using Timer = BasicTimer<std::chrono::high_resolution_clock>;
+	// The timings are recorded in nanoseconds
+	using Timer = BasicTimer<TscClock>;
 }
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "BenchmarkTraceFormat.h"
+#include "../CustomException.h"
+#include <bit>
+
+void benchmark::trace::WriteVarint(std::string& buffer, unsigned long long value)
+{
+	while (value >= 0x80)
+	{
+		buffer.push_back((char)((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back((char)value);
+}
+
+unsigned long long benchmark::trace::ReadVarint(std::istream& stream)
+{
+	unsigned long long value = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		const int byte = stream.get();
+		if (byte == std::char_traits<char>::eof())
+		{
+			throw CREATE_CUSTOM_EXCEPTION("Unexpected end of trace inside a varint");
+		}
+
+		value |= (unsigned long long)(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+		{
+			return value;
+		}
+	}
+	throw CREATE_CUSTOM_EXCEPTION("Varint inside trace is too long");
+}
+
+void benchmark::trace::WriteDouble(std::string& buffer, double value)
+{
+	const unsigned long long bits = std::bit_cast<unsigned long long>(value);
+	for (int shift = 0; shift < 64; shift += 8)
+	{
+		buffer.push_back((char)((bits >> shift) & 0xff));
+	}
+}
+
+double benchmark::trace::ReadDouble(std::istream& stream)
+{
+	unsigned long long bits = 0;
+	for (int shift = 0; shift < 64; shift += 8)
+	{
+		const int byte = stream.get();
+		if (byte == std::char_traits<char>::eof())
+		{
+			throw CREATE_CUSTOM_EXCEPTION("Unexpected end of trace inside a double");
+		}
+		bits |= (unsigned long long)byte << shift;
+	}
+	return std::bit_cast<double>(bits);
+}
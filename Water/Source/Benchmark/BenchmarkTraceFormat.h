@@ -0,0 +1,53 @@
+#pragma once
+
+// The binary trace format written by "Manager". A trace consists of a header followed
+// by records, where every record starts with its "RecordType". Names and thread ids are
+// interned, i.e., they are written once and then referred to by small indices. All integers
+// are stored as varints and the timepoints are stored as deltas, which makes a timing record
+// only a handful of bytes large.
+namespace benchmark
+{
+	namespace trace
+	{
+		// Every trace starts with these bytes, followed by the version
+		inline constexpr char MAGIC[] = { 'W', 'T', 'R', 'C' };
+		inline constexpr unsigned char VERSION = 5;
+
+		enum class RecordType : unsigned char
+		{
+			// Process id, name
+			Session,
+			// Name id, name. The name ids are the scope ids and are therefore not written in order.
+			Name,
+			// Thread index, thread id
+			ThreadId,
+			// Process id, thread index, name
+			ThreadName,
+			// Process id, name id, thread index, timepoint delta, duration. The times are in nanoseconds.
+			Timing,
+			// Process id, thread index, frame number, timepoint delta, duration, 
+			// phase count, phase durations, whether or not the frame is a hitch
+			Frame,
+			// Process id, name id, timepoint delta, value. The value is stored as the 8 bytes of a double.
+			Counter
+		};
+
+		// Stores 7 bits per byte, where the highest bit tells whether or not another byte follows
+		void WriteVarint(std::string& buffer, unsigned long long value);
+		unsigned long long ReadVarint(std::istream& stream);
+		// Stores the bytes of "value" in little-endian order
+		void WriteDouble(std::string& buffer, double value);
+		double ReadDouble(std::istream& stream);
+
+		// Maps signed integers to unsigned integers, so that values close to zero, 
+		// including the negative ones, become short varints
+		constexpr unsigned long long EncodeZigzag(const long long value)
+		{
+			return ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63);
+		}
+		constexpr long long DecodeZigzag(const unsigned long long value)
+		{
+			return (long long)(value >> 1) ^ -(long long)(value & 1);
+		}
+	}
+}
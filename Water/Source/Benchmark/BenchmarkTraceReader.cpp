@@ -0,0 +1,169 @@
+#include "BenchmarkTraceReader.h"
+#include "BenchmarkTraceFormat.h"
+#include "../CustomException.h"
+
+benchmark::TraceReader::TraceReader(const std::string& filePath)
+	:
+	mFilePath(filePath)
+{
+	// We do not set the failbit, since reaching the end of the trace is expected
+	mFile.exceptions(std::ios::badbit);
+	mFile.open(filePath, std::ios::binary);
+
+	// Since we did not set the failbit, we have to manually check for a fail
+	if (!mFile.good())
+	{
+		throw CREATE_CUSTOM_EXCEPTION("Failed to open: " + filePath);
+	}
+}
+
+void benchmark::TraceReader::Read(const Handlers& handlers)
+{
+	ReadHeader();
+
+	int type = 0;
+	while ((type = mFile.get()) != std::char_traits<char>::eof())
+	{
+		switch ((trace::RecordType)type)
+		{
+		case trace::RecordType::Session:
+		{
+			const unsigned int processId = (unsigned int)trace::ReadVarint(mFile);
+			handlers.onSession(data::Session(ReadString()), processId);
+			break;
+		}
+		case trace::RecordType::Name:
+		{
+			const unsigned int nameId = (unsigned int)trace::ReadVarint(mFile);
+			// Every name is only written once per trace
+			if (!mNames.insert({ nameId, ReadString() }).second)
+			{
+				throw CREATE_CUSTOM_EXCEPTION("Name id " + std::to_string(nameId) + " is written twice inside: " + mFilePath);
+			}
+			break;
+		}
+		case trace::RecordType::ThreadId:
+		{
+			const unsigned int threadIndex = (unsigned int)trace::ReadVarint(mFile);
+			if (threadIndex != mThreadIds.size())
+			{
+				throw CREATE_CUSTOM_EXCEPTION("Thread indices are out of order inside: " + mFilePath);
+			}
+			mThreadIds.push_back((unsigned int)trace::ReadVarint(mFile));
+			mPreviousTimepoints.push_back(0);
+			break;
+		}
+		case trace::RecordType::ThreadName:
+		{
+			const unsigned int processId = (unsigned int)trace::ReadVarint(mFile);
+			const unsigned int threadIndex = ReadIndex(mThreadIds.size());
+			handlers.onThread(data::Thread(ReadString(), mThreadIds[threadIndex]), processId);
+			break;
+		}
+		case trace::RecordType::Timing:
+		{
+			const unsigned int processId = (unsigned int)trace::ReadVarint(mFile);
+			const unsigned int nameId = (unsigned int)trace::ReadVarint(mFile);
+			const unsigned int threadIndex = ReadIndex(mThreadIds.size());
+
+			const long long timepoint = ReadTimepoint(threadIndex);
+			const long long duration = (long long)trace::ReadVarint(mFile);
+
+			handlers.onTiming(
+				data::Timing(nameId, timepoint, duration, mThreadIds[threadIndex]), GetName(nameId), processId);
+			break;
+		}
+		case trace::RecordType::Frame:
+		{
+			const unsigned int processId = (unsigned int)trace::ReadVarint(mFile);
+			const unsigned int threadIndex = ReadIndex(mThreadIds.size());
+			const unsigned long long number = trace::ReadVarint(mFile);
+			const long long timepoint = ReadTimepoint(threadIndex);
+			const long long duration = (long long)trace::ReadVarint(mFile);
+
+			std::array<long long, FRAME_PHASE_COUNT> phaseDurations = {};
+			if (trace::ReadVarint(mFile) != phaseDurations.size())
+			{
+				throw CREATE_CUSTOM_EXCEPTION("Unexpected number of frame phases inside: " + mFilePath);
+			}
+			for (long long& phaseDuration : phaseDurations)
+			{
+				phaseDuration = (long long)trace::ReadVarint(mFile);
+			}
+			const bool isHitch = mFile.get() == 1;
+
+			handlers.onFrame(
+				data::Frame(number, timepoint, duration, mThreadIds[threadIndex], phaseDurations, isHitch), processId);
+			break;
+		}
+		case trace::RecordType::Counter:
+		{
+			const unsigned int processId = (unsigned int)trace::ReadVarint(mFile);
+			const unsigned int counterId = (unsigned int)trace::ReadVarint(mFile);
+			mPreviousCounterTimepoint += trace::DecodeZigzag(trace::ReadVarint(mFile));
+			const double value = trace::ReadDouble(mFile);
+
+			handlers.onCounter(data::Counter(counterId, mPreviousCounterTimepoint, value), GetName(counterId), processId);
+			break;
+		}
+		default:
+			throw CREATE_CUSTOM_EXCEPTION("Unknown record type " + std::to_string(type) + " inside: " + mFilePath);
+		}
+	}
+}
+
+void benchmark::TraceReader::ReadHeader()
+{
+	char magic[std::size(trace::MAGIC)] = {};
+	mFile.read(magic, std::size(magic));
+	if (!std::equal(std::begin(magic), std::end(magic), std::begin(trace::MAGIC)))
+	{
+		throw CREATE_CUSTOM_EXCEPTION("\"" + mFilePath + "\"" + " is not a benchmark trace");
+	}
+
+	const int version = mFile.get();
+	if (version != trace::VERSION)
+	{
+		throw CREATE_CUSTOM_EXCEPTION("\"" + mFilePath + "\"" + " has unsupported trace version " + std::to_string(version));
+	}
+}
+
+std::string benchmark::TraceReader::ReadString()
+{
+	std::string string;
+	string.resize((size_t)trace::ReadVarint(mFile));
+	mFile.read(string.data(), (std::streamsize)string.size());
+	if (mFile.gcount() != (std::streamsize)string.size())
+	{
+		throw CREATE_CUSTOM_EXCEPTION("Unexpected end of trace inside a string: " + mFilePath);
+	}
+	return string;
+}
+
+unsigned int benchmark::TraceReader::ReadIndex(size_t size)
+{
+	const unsigned long long index = trace::ReadVarint(mFile);
+	// Make sure that the index refers to something that has already been interned
+	if (index >= size)
+	{
+		throw CREATE_CUSTOM_EXCEPTION("Reference to an unknown thread inside: " + mFilePath);
+	}
+	return (unsigned int)index;
+}
+
+long long benchmark::TraceReader::ReadTimepoint(unsigned int threadIndex)
+{
+	long long& previousTimepoint = mPreviousTimepoints[threadIndex];
+	previousTimepoint += trace::DecodeZigzag(trace::ReadVarint(mFile));
+	return previousTimepoint;
+}
+
+const std::string& benchmark::TraceReader::GetName(unsigned int nameId) const
+{
+	const auto it = mNames.find(nameId);
+	if (it == mNames.end())
+	{
+		throw CREATE_CUSTOM_EXCEPTION("Reference to an unknown name inside: " + mFilePath);
+	}
+	return it->second;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <fstream>
+#include "Data/All.h"
+
+namespace benchmark
+{
+	// Decodes a binary trace (see "BenchmarkTraceFormat.h") back into events
+	class TraceReader
+	{
+	public:
+		// Gets called once for every event inside the trace, in the order they were written
+		struct Handlers
+		{
+			std::function<void(const data::Session&, unsigned int processId)> onSession = [](const auto&, auto) {};
+			std::function<void(const data::Thread&, unsigned int processId)> onThread = [](const auto&, auto) {};
+			// "scopeName" is the name of the scope that the timing's scope id refers to
+			std::function<void(const data::Timing&, const std::string& scopeName, unsigned int processId)> onTiming = 
+				[](const auto&, const auto&, auto) {};
+			std::function<void(const data::Frame&, unsigned int processId)> onFrame = [](const auto&, auto) {};
+			// "counterName" is the name of the counter that the counter id refers to
+			std::function<void(const data::Counter&, const std::string& counterName, unsigned int processId)> onCounter =
+				[](const auto&, const auto&, auto) {};
+		};
+
+		TraceReader(const std::string& filePath);
+
+		// Reads the whole trace
+		void Read(const Handlers& handlers);
+	private:
+		void ReadHeader();
+		std::string ReadString();
+		unsigned int ReadIndex(size_t size);
+		// Reads a timepoint delta and returns the absolute timepoint
+		long long ReadTimepoint(unsigned int threadIndex);
+		// Returns the name of "nameId", which has to have been read already
+		const std::string& GetName(unsigned int nameId) const;
+	private:
+		std::string mFilePath;
+		std::ifstream mFile;
+		std::unordered_map<unsigned int, std::string> mNames;
+		std::vector<unsigned int> mThreadIds;
+		std::vector<long long> mPreviousTimepoints;
+		long long mPreviousCounterTimepoint = 0;
+	};
+}
@@ -0,0 +1,151 @@
+#include "BenchmarkTraceWriter.h"
+#include "BenchmarkTraceFormat.h"
+
+benchmark::TraceWriter::TraceWriter()
+{
+	WriteHeader();
+}
+
+void benchmark::TraceWriter::WriteSession(const data::Session& data, unsigned int processId)
+{
+	mBuffer.push_back((char)trace::RecordType::Session);
+	trace::WriteVarint(mBuffer, processId);
+	WriteString(data.name);
+}
+
+void benchmark::TraceWriter::WriteThread(const data::Thread& data, unsigned int processId)
+{
+	const unsigned int threadIndex = InternThread(data.threadId);
+
+	mBuffer.push_back((char)trace::RecordType::ThreadName);
+	trace::WriteVarint(mBuffer, processId);
+	trace::WriteVarint(mBuffer, threadIndex);
+	WriteString(data.name);
+}
+
+void benchmark::TraceWriter::WriteTiming(const data::Timing& data, const char* scopeName, unsigned int processId)
+{
+	InternScope(data.scopeId, scopeName);
+	const unsigned int threadIndex = InternThread(data.threadId);
+
+	mBuffer.push_back((char)trace::RecordType::Timing);
+	trace::WriteVarint(mBuffer, processId);
+	trace::WriteVarint(mBuffer, data.scopeId);
+	trace::WriteVarint(mBuffer, threadIndex);
+	WriteTimepoint(threadIndex, data.timepoint);
+	trace::WriteVarint(mBuffer, (unsigned long long)data.duration);
+}
+
+void benchmark::TraceWriter::WriteFrame(const data::Frame& data, unsigned int processId)
+{
+	const unsigned int threadIndex = InternThread(data.threadId);
+
+	mBuffer.push_back((char)trace::RecordType::Frame);
+	trace::WriteVarint(mBuffer, processId);
+	trace::WriteVarint(mBuffer, threadIndex);
+	trace::WriteVarint(mBuffer, data.number);
+	WriteTimepoint(threadIndex, data.timepoint);
+	trace::WriteVarint(mBuffer, (unsigned long long)data.duration);
+	trace::WriteVarint(mBuffer, data.phaseDurations.size());
+	for (const long long phaseDuration : data.phaseDurations)
+	{
+		trace::WriteVarint(mBuffer, (unsigned long long)phaseDuration);
+	}
+	mBuffer.push_back((char)data.isHitch);
+}
+
+void benchmark::TraceWriter::WriteCounter(const data::Counter& data, const char* counterName, unsigned int processId)
+{
+	InternScope(data.counterId, counterName);
+
+	const long long timepointDelta = data.timepoint - mPreviousCounterTimepoint;
+	mPreviousCounterTimepoint = data.timepoint;
+
+	mBuffer.push_back((char)trace::RecordType::Counter);
+	trace::WriteVarint(mBuffer, processId);
+	trace::WriteVarint(mBuffer, data.counterId);
+	trace::WriteVarint(mBuffer, trace::EncodeZigzag(timepointDelta));
+	trace::WriteDouble(mBuffer, data.value);
+}
+
+void benchmark::TraceWriter::Flush(std::ostream& stream)
+{
+	stream.write(mBuffer.data(), (std::streamsize)mBuffer.size());
+	mBuffer.clear();
+}
+
+size_t benchmark::TraceWriter::GetBufferSize() const
+{
+	return mBuffer.size();
+}
+
+void benchmark::TraceWriter::Reset()
+{
+	mBuffer.clear();
+	mWrittenScopes.clear();
+	mThreadIdToIndex.clear();
+	mPreviousTimepoints.clear();
+	mPreviousCounterTimepoint = 0;
+	WriteHeader();
+}
+
+void benchmark::TraceWriter::WriteHeader()
+{
+	mBuffer.append(std::begin(trace::MAGIC), std::end(trace::MAGIC));
+	mBuffer.push_back((char)trace::VERSION);
+}
+
+void benchmark::TraceWriter::WriteString(const std::string& string)
+{
+	trace::WriteVarint(mBuffer, string.size());
+	mBuffer.append(string);
+}
+
+void benchmark::TraceWriter::InternScope(unsigned int scopeId, const char* scopeName)
+{
+	if (scopeId < mWrittenScopes.size() && mWrittenScopes[scopeId])
+	{
+		return;
+	}
+
+	if (scopeId >= mWrittenScopes.size())
+	{
+		mWrittenScopes.resize(scopeId + 1);
+	}
+	mWrittenScopes[scopeId] = true;
+
+	// The scope id doubles as the name id
+	mBuffer.push_back((char)trace::RecordType::Name);
+	trace::WriteVarint(mBuffer, scopeId);
+	WriteString(scopeName);
+}
+
+unsigned int benchmark::TraceWriter::InternThread(unsigned int threadId)
+{
+	const auto it = mThreadIdToIndex.find(threadId);
+	if (it != mThreadIdToIndex.end())
+	{
+		return it->second;
+	}
+
+	const unsigned int threadIndex = (unsigned int)mThreadIdToIndex.size();
+	mThreadIdToIndex.insert({ threadId, threadIndex });
+	mPreviousTimepoints.push_back(0);
+
+	mBuffer.push_back((char)trace::RecordType::ThreadId);
+	trace::WriteVarint(mBuffer, threadIndex);
+	trace::WriteVarint(mBuffer, threadId);
+
+	return threadIndex;
+}
+
+void benchmark::TraceWriter::WriteTimepoint(unsigned int threadIndex, long long timepoint)
+{
+	long long& previousTimepoint = mPreviousTimepoints[threadIndex];
+	const long long timepointDelta = timepoint - previousTimepoint;
+	previousTimepoint = timepoint;
+
+	// A thread's timings are ordered by when they end, so a scope that encloses
+	// the previous scope has an earlier timepoint. The delta can therefore be negative.
+	trace::WriteVarint(mBuffer, trace::EncodeZigzag(timepointDelta));
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "Data/All.h"
+
+namespace benchmark
+{
+	// Encodes events into the binary trace format (see "BenchmarkTraceFormat.h").
+	// The records are buffered until Flush() gets called.
+	class TraceWriter
+	{
+	public:
+		TraceWriter();
+
+		void WriteSession(const data::Session& data, unsigned int processId);
+		void WriteThread(const data::Thread& data, unsigned int processId);
+		// "scopeName" is the name of the scope that "data.scopeId" refers to
+		void WriteTiming(const data::Timing& data, const char* scopeName, unsigned int processId);
+		void WriteFrame(const data::Frame& data, unsigned int processId);
+		// "counterName" is the name of the counter that "data.counterId" refers to
+		void WriteCounter(const data::Counter& data, const char* counterName, unsigned int processId);
+
+		// Writes all of the buffered records into "stream"
+		void Flush(std::ostream& stream);
+		// The number of bytes that are waiting for Flush()
+		size_t GetBufferSize() const;
+		// Forgets all of the interned scopes and thread ids and restarts the
+		// trace with a header. Should get called when the trace is written into a new file.
+		void Reset();
+	private:
+		void WriteHeader();
+		void WriteString(const std::string& string);
+		// Writes a name record for the scope, unless the scope has already been written
+		void InternScope(unsigned int scopeId, const char* scopeName);
+		// Returns the index of "threadId", writing a thread id record if the thread has not been seen before
+		unsigned int InternThread(unsigned int threadId);
+		// Writes the timepoint as a delta to the previous timepoint of the thread
+		void WriteTimepoint(unsigned int threadIndex, long long timepoint);
+	private:
+		std::string mBuffer;
+		// Whether or not a name record has been written for each scope, indexed by scope id
+		std::vector<bool> mWrittenScopes;
+		std::unordered_map<unsigned int, unsigned int> mThreadIdToIndex;
+		// The timepoint of each thread's previous timing, indexed by thread index. Since a thread's 
+		// timings are close to each other in time, the deltas become much shorter than the timepoints.
+		std::vector<long long> mPreviousTimepoints;
+		// Counters do not belong to a thread, so they have their own previous timepoint
+		long long mPreviousCounterTimepoint = 0;
+	};
+}
@@ -0,0 +1,31 @@
+#include "BenchmarkTscClock.h"
+#include <thread>
+
+void benchmark::TscClock::Calibrate()
+{
+	// Reads the timestamp counter and the steady clock as close to each other as possible
+	auto readBoth = []()
+	{
+		const long long ticks = (long long)__rdtsc();
+		const long long nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+		return std::make_pair(ticks, nanoseconds);
+	};
+
+	const auto [startTicks, startNanoseconds] = readBoth();
+	std::this_thread::sleep_for(CALIBRATION_DURATION);
+	const auto [endTicks, endNanoseconds] = readBoth();
+
+	const double nanosecondsPerTick = (double)(endNanoseconds - startNanoseconds) / (double)(endTicks - startTicks);
+
+	// Only the publishing is serialized, so concurrent calibrations still sleep in parallel
+	std::lock_guard lockGuard(mCalibrationMutex);
+	const unsigned int sequence = mSequence.load(std::memory_order_relaxed);
+	mSequence.store(sequence + 1, std::memory_order_relaxed);
+	// The odd sequence has to be visible before any of the fields change
+	std::atomic_thread_fence(std::memory_order_release);
+	mNanosecondsPerTick.store(nanosecondsPerTick, std::memory_order_relaxed);
+	mCalibrationNanoseconds.store(endNanoseconds, std::memory_order_relaxed);
+	mCalibrationTicks.store(endTicks, std::memory_order_relaxed);
+	mSequence.store(sequence + 2, std::memory_order_release);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <intrin.h>
+
+namespace benchmark
+{
+	// A clock that reads the CPU's timestamp counter, which is much cheaper than reading
+	// "std::chrono::steady_clock". The counter runs at a fixed rate that is unknown at compile 
+	// time, so it has to be calibrated against "std::chrono::steady_clock", see Calibrate().
+	// The time points are converted into the same epoch as "std::chrono::steady_clock".
+	class TscClock
+	{
+	public:
+		using rep = long long;
+		using period = std::nano;
+		using duration = std::chrono::duration<rep, period>;
+		using time_point = std::chrono::time_point<TscClock, duration>;
+		// Assumes an invariant timestamp counter, which all modern x64 processors have
+		static constexpr bool is_steady = true;
+
+		static time_point now()
+		{
+			long long calibrationTicks;
+			long long calibrationNanoseconds;
+			double nanosecondsPerTick;
+			// Retries until it has read a calibration that was not being written at the same time, so that
+			// it never combines the fields of two different calibrations
+			unsigned int sequence;
+			do
+			{
+				sequence = mSequence.load(std::memory_order_acquire);
+				calibrationTicks = mCalibrationTicks.load(std::memory_order_relaxed);
+				calibrationNanoseconds = mCalibrationNanoseconds.load(std::memory_order_relaxed);
+				nanosecondsPerTick = mNanosecondsPerTick.load(std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_acquire);
+			} while ((sequence & 1) != 0 || sequence != mSequence.load(std::memory_order_relaxed));
+
+			const long long ticks = (long long)__rdtsc() - calibrationTicks;
+			const double nanoseconds = (double)ticks * nanosecondsPerTick;
+			return time_point(duration(calibrationNanoseconds + (long long)nanoseconds));
+		}
+
+		// Measures the rate of the timestamp counter. Blocks the calling thread for "CALIBRATION_DURATION".
+		// Thread-safe. The time points switch from the previous calibration to the new one at once.
+		static void Calibrate();
+	private:
+		static constexpr std::chrono::milliseconds CALIBRATION_DURATION{ 20 };
+
+		// A sequence lock around the calibration. It is odd while a calibration is being written.
+		inline static std::atomic<unsigned int> mSequence = 0;
+		// Serializes the writers of the calibration
+		inline static std::mutex mCalibrationMutex;
+		// The timestamp counter and the steady clock were read at the same time
+		inline static std::atomic<long long> mCalibrationTicks = 0;
+		inline static std::atomic<long long> mCalibrationNanoseconds = 0;
+		inline static std::atomic<double> mNanosecondsPerTick = 0.0;
+	};
+}
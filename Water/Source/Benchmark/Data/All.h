@@ -1,4 +1,6 @@
 #pragma once
 #include "TimingData.h"
 #include "SessionData.h"
-#include "ThreadData.h"
\ No newline at end of file
+#include "ThreadData.h"
+#include "FrameData.h"
+#include "CounterData.h"
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include "CounterData.h"
+
+benchmark::data::Counter::Counter(unsigned int counterId, long long timepoint, double value)
+	:
+	counterId(counterId),
+	timepoint(timepoint),
+	value(value)
+{
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace benchmark
+{
+	namespace data
+	{
+		struct Counter
+		{
+			// Enables "Counter" to be stored inside preallocated buffers
+			Counter() = default;
+			Counter(unsigned int counterId, long long timepoint, double value);
+			// Refers to the "ScopeDescriptor" of the counter
+			unsigned int counterId = 0;
+			// In nanoseconds
+			long long timepoint = 0;
+			double value = 0.0;
+		};
+	}
+}
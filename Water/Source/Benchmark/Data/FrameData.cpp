@@ -0,0 +1,13 @@
+#include "FrameData.h"
+
+benchmark::data::Frame::Frame(unsigned long long number, long long timepoint, long long duration, unsigned int threadId,
+							  const std::array<long long, FRAME_PHASE_COUNT>& phaseDurations, bool isHitch)
+	:
+	number(number),
+	timepoint(timepoint),
+	duration(duration),
+	threadId(threadId),
+	phaseDurations(phaseDurations),
+	isHitch(isHitch)
+{
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <array>
+#include "../BenchmarkFramePhase.h"
+
+namespace benchmark
+{
+	namespace data
+	{
+		struct Frame
+		{
+			Frame() = default;
+			Frame(unsigned long long number, long long timepoint, long long duration, unsigned int threadId,
+				  const std::array<long long, FRAME_PHASE_COUNT>& phaseDurations, bool isHitch);
+			unsigned long long number = 0;
+			// In nanoseconds
+			long long timepoint = 0;
+			long long duration = 0;
+			unsigned int threadId = 0;
+			// Indexed by "FramePhase"
+			std::array<long long, FRAME_PHASE_COUNT> phaseDurations = {};
+			// Whether or not the frame exceeded the frame budget
+			bool isHitch = false;
+		};
+	}
+}
@@ -1,9 +1,9 @@
 #include "TimingData.h"
 
-benchmark::data::Timing::Timing(const std::string& name, long long timepoint, 
+benchmark::data::Timing::Timing(unsigned int scopeId, long long timepoint, 
 							    long long duration, unsigned int threadId)
 	:
-	name(name),
+	scopeId(scopeId),
 	timepoint(timepoint),
 	duration(duration),
 	threadId(threadId)
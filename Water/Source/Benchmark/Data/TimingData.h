@@ -6,9 +6,14 @@ namespace benchmark
 	{
 		struct Timing
 		{
-			Timing(const std::string& name, long long timepoint, 
+			// Enables "Timing" to be stored inside preallocated buffers
+			Timing() = default;
+			Timing(unsigned int scopeId, long long timepoint, 
 				   long long duration, unsigned int threadId);
-			std::string name;
+			// Refers to a "ScopeDescriptor". Storing the id instead of the name keeps 
+			// "Timing" small and free from allocations.
+			unsigned int scopeId = 0;
+			// In nanoseconds
 			long long timepoint = 0;
 			long long duration = 0;
 			unsigned int threadId = 0;
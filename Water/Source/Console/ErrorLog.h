@@ -11,6 +11,7 @@
 #define ERROR_LOG(message) \
 { \
 	std::lock_guard CONCATENATE(lockGuard, __LINE__)(gLogMutex); \
+	++gLogCount; \
 	std::cerr \
 	<< "{" << std::endl << "Error:" << std::endl << message << std::endl \
 	<< std::endl << "Caught at: " << std::endl << "Filename: " << __FILE__ << std::endl \
@@ -11,6 +11,7 @@
 #define LOG(message) \
 { \
 	std::lock_guard CONCATENATE(lockGuard, __LINE__)(gLogMutex); \
+	++gLogCount; \
 	std::cout << message; \
 }
 #else
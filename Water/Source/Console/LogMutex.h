@@ -1,6 +1,9 @@
 #pragma once
 #include <mutex>
+#include <atomic>
 
 // This mutex should get locked during logging. It is a recursive mutex,
 // since it should be able to get locked multiple times by the same thread.
 inline std::recursive_mutex gLogMutex;
+// The number of messages that have been logged. Enables the benchmarking to track the log rate.
+inline std::atomic<unsigned long long> gLogCount = 0;
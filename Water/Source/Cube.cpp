@@ -1,11 +1,16 @@
 #include "Cube.h"
 #include "Rendering/GlMacro.h"
 #include "Rendering/Vertex.h"
+#include "Benchmark/BenchmarkMacros.h"
+#include "Noise/NoiseTableRegistry.h"
+#include "Noise/PerlinNoise.h"
+#include "Noise/NoiseBaker.h"
 
 Cube::Cube(const std::string& programName, const std::string& distortionProgramName, const Vector3& position, const float scale)
 	:
 	mProgram(programName),
 	mDistortionProgram(distortionProgramName),
+	mBakedNoise(3, BAKED_NOISE_RESOLUTION, BakeNoise()),
 	mPosition(position),
 	mScale(scale)
 
@@ -25,6 +30,8 @@ Cube::~Cube()
 
 void Cube::Render(const Camera& camera, const Matrix4& projectionMatrix) const
 {
+	GPU_BENCHMARK("Cube");
+
 	mProgram.Bind();
 
 	GL(glBindVertexArray(mVao));
@@ -37,16 +44,32 @@ void Cube::Render(const Camera& camera, const Matrix4& projectionMatrix) const
 
 void Cube::RenderWaterDistortion(const float time, const Camera& camera, const Matrix4& projectionMatrix) const
 {
+	GPU_BENCHMARK("Cube with distortion");
+
 	mDistortionProgram.Bind();
 
 	GL(glBindVertexArray(mVao));
 	GL(glBindTextureUnit(1, mTexture));
+	mBakedNoise.Bind(3);
 
 	BindDistortionUniforms(time, camera, projectionMatrix);
 
 	glDrawArrays(GL_TRIANGLES, 0, AMOUNT_OF_VERTICES);
 }
 
+void Cube::SetUseBakedNoise(bool useBakedNoise)
+{
+	mUseBakedNoise = useBakedNoise;
+}
+
+std::vector<float> Cube::BakeNoise()
+{
+	BENCHMARK;
+
+	const PerlinNoise<3> perlinNoise(NoiseTableRegistry::GetPermutationTable<256>());
+	return noise::BakeTileable<3>(perlinNoise, BAKED_NOISE_RESOLUTION, BAKED_NOISE_PERIOD);
+}
+
 void Cube::InitializeVao()
 {
 	GL(glCreateVertexArrays(1, &mVao));
@@ -186,5 +209,6 @@ void Cube::BindUniforms(const Camera& camera, const Matrix4& projectionMatrix) c
 void Cube::BindDistortionUniforms(const float time, const Camera& camera, const Matrix4& projectionMatrix) const
 {
 	GL(glUniform1f(3, time));
+	GL(glUniform1i(6, mUseBakedNoise));
 	BindUniforms(camera, projectionMatrix);
 }
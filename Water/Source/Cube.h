@@ -2,6 +2,7 @@
 #include "Rendering/Program.h"
 #include "Rendering/Camera.h"
 #include "Mathematics/Matrix/Matrix.h"
+#include "Rendering/NoiseTexture.h"
 
 class Cube
 {
@@ -12,7 +13,10 @@ public:
 	// Distorts the cube's texture and vertices, as if the cube is seen through a surface of water
 	void RenderWaterDistortion(float time, const Camera& camera, 
 		const Matrix4& projectionMatrix) const;
+	// Makes the distortion fetch the noise from "mBakedNoise", instead of evaluating it
+	void SetUseBakedNoise(bool useBakedNoise);
 private:
+	static std::vector<float> BakeNoise();
 	void InitializeVao();
 	void InitializeVbo();
 	void InitializeTexture();
@@ -26,6 +30,14 @@ private:
 	GLuint mVao = 0;
 	GLuint mVbo = 0;
 	GLuint mTexture = 0;
+	// Tileable 3D noise with its gradient, baked on the CPU. The third dimension is the time,
+	// so the distortion loops once the time has passed a whole period.
+	NoiseTexture mBakedNoise;
+	bool mUseBakedNoise = false;
+	static constexpr int BAKED_NOISE_RESOLUTION = 128;
+	// Needs to match "NOISE_PERIOD" inside of the distortion shader, which wraps its procedural noise
+	// at the same period, so that switching to the baked noise does not change the distortion
+	static constexpr int BAKED_NOISE_PERIOD = 16;
 
 	Vector3 mPosition;
 	float mScale = 0.0f;
@@ -5,6 +5,7 @@
 #include <optional>
 #include "Keyboard.h"
 #include "CustomException.h"
+#include "Benchmark/BenchmarkMacros.h"
 
 template<class T>
 class DynamicVariableManager
@@ -58,6 +59,19 @@ public:
 				++index;
 			});
 
+		#if ENABLE_BENCHMARKING
+			// Publish the variables as counters, so that their changes show up in the benchmark
+			for (size_t i = 0; i < mVariables.size(); ++i)
+			{
+				mCounters.push_back(std::make_unique<benchmark::Counter>(
+					mFilename + "." + mVariableIndexToName.at(int(i)), [this, i]()
+					{
+						std::lock_guard lockGuard(mMutex);
+						return (double)mVariables[i];
+					}));
+			}
+		#endif
+
 		// Run the loop on a separate thread, so that we do not stall the main thread
 		// when we are waiting for the user
 		mThread = std::thread(&DynamicVariableManager::Loop, this);
@@ -341,6 +355,11 @@ private:
 
 	float mUpdateSpeed = 5.0f;
 	float mUpdateAcceleration = 1.0f;
+	#if ENABLE_BENCHMARKING
+		// Declared last, so that the counters stop sampling the variables before the variables are destroyed
+		std::vector<std::unique_ptr<benchmark::Counter>> mCounters;
+	#endif
+
 	inline static const std::string FILE_PATH = "Source/DynamicVariableFiles/";
 	inline static const std::string FILE_EXTENSION = ".txt";
 };
\ No newline at end of file
@@ -45,7 +45,7 @@ void Game::BeginLoop()
 
 void Game::Loop()
 {
-    BENCHMARK;
+    BENCHMARK_FRAME;
 
     GL(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
 
@@ -54,28 +54,44 @@ void Game::Loop()
 
     mDeltaTime = (float)mTimer.Time();
 
-    NAMED_BENCHMARK("Swap and poll");
+    BENCHMARK_FRAME_PHASE(Swap);
     // Swap front and back buffers
     mWindow.SwapBuffers();
 
     // Poll for and process events
     mWindow.PollEvents();
+
+    COLLECT_GPU_BENCHMARKS;
+    SAMPLE_BENCHMARK_COUNTERS;
 }
 
 void Game::Update()
 {
-    BENCHMARK;
+    BENCHMARK_FRAME_PHASE(Update);
     // LOG(1.0f / mDeltaTime << std::endl);
 
     mTime += (double)mDeltaTime;
    
     mCamera.UpdatePosition(mDeltaTime);
     mWater.Update(mDeltaTime);
+
+    // Only toggle once per key press
+    const bool bakedNoiseKeyIsPressed = Keyboard::KeyIsPressed(GLFW_KEY_B);
+    if (bakedNoiseKeyIsPressed && !mBakedNoiseKeyWasPressed)
+    {
+        mUseBakedNoise = !mUseBakedNoise;
+        mWater.SetUseBakedNoise(mUseBakedNoise);
+        mCube.SetUseBakedNoise(mUseBakedNoise);
+        LOG("Baked noise = " << (mUseBakedNoise ? "on" : "off") << std::endl);
+    }
+    mBakedNoiseKeyWasPressed = bakedNoiseKeyIsPressed;
 }
 
 void Game::Render() const
 {
     BENCHMARK;
+    // Named apart from the "Render" frame phase, since the comparator tells the scopes apart by name only
+    GPU_BENCHMARK("GPU render");
 
     // Render the scene with a water effect, if the
     // camera is inside the water
@@ -85,6 +101,8 @@ void Game::Render() const
 
 void Game::RenderWithPostProcessingEffect()
 {
+    BENCHMARK_FRAME_PHASE(Render);
+
     if (mWater.IsPointInside(mCamera.GetPosition()))
     {
         // If the camera is inside the water, render the cube
@@ -35,6 +35,11 @@ private:
 	float mDeltaTime = 1.0f / 60.0f;
 	double mTime = 0.0f;
 
+	// Toggled with the B key. Whether the water and the cube should fetch the
+	// noise from textures that were baked on the CPU, instead of evaluating it.
+	bool mUseBakedNoise = false;
+	bool mBakedNoiseKeyWasPressed = false;
+
 	// Some GPUs require that we have a vertex array 
 	// object bound and this vertex array object exists
 	// solely to fulfill that requirement
@@ -39,7 +39,6 @@ public:
 	ConstRandomAccessIterator(const T* pointer, ContainerDebugInfo<T>* vectorDebugInfo)
 	{
 		Base::SetContainerDebugInfo(vectorDebugInfo);
-		Base::AddToContainer();
 		assert(pointer);
 		ASSERT_POINTER_IS_GEQUAL_TO_BEGIN(pointer);
 		ASSERT_POINTER_IS_LEQUAL_TO_END(pointer);
@@ -47,13 +46,6 @@ public:
 
 	}
 	ConstRandomAccessIterator() = default;
-	~ConstRandomAccessIterator()
-	{
-		if (Base::HasContainer())
-		{
-			Base::RemoveFromContainer();
-		}
-	}
 
 	[[nodiscard]] bool operator==(const ConstRandomAccessIterator& other) const
 	{
@@ -178,7 +170,6 @@ private:
 	}
 private:
 	using Base = ConstRandomAccessIteratorBase<T>;
-	friend class ContainerDebugInfo<T>;
 	const T* mPointer = nullptr;
 };
 
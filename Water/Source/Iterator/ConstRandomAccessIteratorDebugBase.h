@@ -5,56 +5,23 @@
 template<class T>
 class ConstRandomAccessIteratorDebugBase
 {
-public:
-	ConstRandomAccessIteratorDebugBase& operator=(const ConstRandomAccessIteratorDebugBase& other)
-	{
-		if (HasContainer())
-		{
-			// Remove the old container if we had one
-			RemoveFromContainer();
-		}
-		if (other.HasContainer())
-		{
-			mContainerDebugInfo = other.mContainerDebugInfo;
-			AddToContainer();
-		}
-
-		return *this;
-	}
-	ConstRandomAccessIteratorDebugBase(const ConstRandomAccessIteratorDebugBase& other)
-	{
-		*this = other;
-	}
-	ConstRandomAccessIteratorDebugBase() = default;
 protected:
 	void SetContainerDebugInfo(ContainerDebugInfo<T>* vectorDebugInfo)
 	{
 		mContainerDebugInfo = vectorDebugInfo;
+		mGeneration = vectorDebugInfo ? vectorDebugInfo->GetGeneration() : 0;
 	}
 	const ContainerDebugInfo<T>* const GetContainerDebugInfo() const
-	{
-		return mContainerDebugInfo ? mContainerDebugInfo : nullptr;
-	}
-	void RemoveContainer()
-	{
-		mContainerDebugInfo = nullptr;
-	}
-	bool HasContainer() const
 	{
 		return mContainerDebugInfo;
 	}
-	void AddToContainer()
-	{
-		assert(HasContainer());
-		mContainerDebugInfo->AddIterator(this);
-	}
-	void RemoveFromContainer()
+	// Whether the container still exists, i.e., whether it still has the
+	// generation that it had when the iterator was created
+	bool HasContainer() const
 	{
-		assert(HasContainer());
-		mContainerDebugInfo->RemoveIterator(this);
+		return mContainerDebugInfo && mContainerDebugInfo->GetGeneration() == mGeneration;
 	}
 private:
-	ContainerDebugInfo<T>* mContainerDebugInfo = nullptr;
-	// "ContainerDebugInfo" needs to be able to call RemoveContainer()
-	friend class ContainerDebugInfo<T>;
-};
\ No newline at end of file
+	const ContainerDebugInfo<T>* mContainerDebugInfo = nullptr;
+	uint64_t mGeneration = 0;
+};
@@ -19,10 +19,4 @@ protected:
 	{
 		return nullptr;
 	}
-	void AddToContainer() noexcept
-	{
-	}
-	void RemoveFromContainer() noexcept
-	{
-	}
-};
\ No newline at end of file
+};
@@ -20,8 +20,7 @@ protected:
 	{
 		assert(!mInitialized);
 		mInitialized = true;
-		mContainerDebugInfo.begin = begin;
-		mContainerDebugInfo.end = end;
+		mContainerDebugInfo.Initialize(begin, end);
 	}
 	ContainerDebugInfo<T>* GetContainerDebugInfo()
 	{
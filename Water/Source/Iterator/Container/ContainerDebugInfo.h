@@ -1,9 +1,11 @@
 #pragma once
+#include <atomic>
 
-template<class T>
-class ConstRandomAccessIteratorDebugBase;
-
-// Contains information used by iterators in debug mode
+// Contains information used by iterators in debug mode. Every container gets a generation
+// that no other container has had before, and gives it up when it gets destroyed. An iterator
+// remembers the generation of its container, and is only valid for as long as the container
+// still has that generation. Iterators therefore never need to be registered anywhere, which
+// keeps creating them as cheap as copying a few pointers.
 template<class T>
 class ContainerDebugInfo
 {
@@ -16,35 +18,27 @@ public:
 
 	~ContainerDebugInfo()
 	{
-		InvalidateIterators();
-	}
-	void AddIterator(ConstRandomAccessIteratorDebugBase<T>* iterator)
-	{
-		// Make sure that we have not added this iterator already
-		assert(std::find(mActiveIterators.begin(), 
-			mActiveIterators.end(), iterator) == mActiveIterators.end());
-		mActiveIterators.push_back(iterator);
+		// Invalidates all of the iterators that point into the container
+		mGeneration = INVALID_GENERATION;
 	}
-	void RemoveIterator(ConstRandomAccessIteratorDebugBase<T>* iterator)
+	void Initialize(const T* begin, const T* end)
 	{
-		size_t count = mActiveIterators.remove(iterator);
-		// Make sure we removed precisely one iterator
-		assert(count == 1);
+		this->begin = begin;
+		this->end = end;
+		mGeneration = msNextGeneration.fetch_add(1, std::memory_order_relaxed);
 	}
-private:
-	void InvalidateIterators()
+	uint64_t GetGeneration() const
 	{
-		for (auto& iterator : mActiveIterators)
-		{
-			iterator->RemoveContainer();
-		}
+		return mGeneration;
 	}
 public:
 	const T* begin = nullptr;
 	const T* end = nullptr;
 private:
-	// All the current iterators that points to data inside the associated
-	// container. The only reason they are stored is to be able to, for debug purposes,
-	// invalidate them.
-	std::list<ConstRandomAccessIteratorDebugBase<T>*> mActiveIterators;
-};
\ No newline at end of file
+	static constexpr uint64_t INVALID_GENERATION = 0;
+
+	// Volatile, since the compiler would otherwise drop the store in the destructor, as
+	// nothing is allowed to read the member after that
+	volatile uint64_t mGeneration = INVALID_GENERATION;
+	inline static std::atomic<uint64_t> msNextGeneration = INVALID_GENERATION + 1;
+};
@@ -16,6 +16,9 @@ int main()
     try
     {
         #if ENABLE_BENCHMARKING
+            SET_BENCHMARK_MODE;
+            SET_FRAME_BUDGET;
+            REGISTER_STANDARD_BENCHMARK_COUNTERS;
             // Creating a benchmark session that exists during the entire lifetime of "game"
             benchmarkSession.emplace("Main");
         #endif  
@@ -46,4 +46,14 @@ constexpr int Power(const int value, const int exponent)
 	}
 
 	return result;
-}
\ No newline at end of file
+}
+// "std::sqrt" is not constexpr, so this uses Newton's method instead. "value" has to be non-negative.
+constexpr double SquareRoot(const double value)
+{
+	double root = value > 1.0 ? value : 1.0;
+	for (int i = 0; i < 64; ++i)
+	{
+		root = (root + value / root) / 2.0;
+	}
+	return root;
+}
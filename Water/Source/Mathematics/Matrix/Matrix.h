@@ -76,6 +76,19 @@ public:
 
 	[[nodiscard]] BasicMatrix operator*(const BasicMatrix& other) const
 	{
+		if constexpr (IS_ACCELERATED)
+		{
+			// Every column of the product is this matrix times a column of "other", e.g., 16
+			// multiply-adds for a 4x4 matrix
+			const std::array<__m128, N> columns = LoadColumns();
+			BasicMatrix product;
+			for (int i = 0; i < N; ++i)
+			{
+				product.StoreColumn(i, simd::float4::Transform<N>(columns, other.LoadColumn(i)));
+			}
+			return product;
+		}
+
 		BasicMatrix temporary;
 		for (int otherX = 0; otherX < N; ++otherX)
 		{
@@ -93,6 +106,13 @@ public:
 	}
 	[[nodiscard]] BasicVector<T, N> operator*(const BasicVector<T, N>& vector) const
 	{
+		if constexpr (IS_ACCELERATED)
+		{
+			BasicVector<T, N> product;
+			product.Store(simd::float4::Transform<N>(LoadColumns(), vector.Load()));
+			return product;
+		}
+
 		BasicVector<T, N> temporary;
 		for (int y = 0; y < N; ++y)
 		{
@@ -110,6 +130,44 @@ public:
 		*this = (*this) * other;
 		return *this;
 	}
+private:
+	static constexpr bool IS_ACCELERATED = simd::float4::IS_ACCELERATED<T, N>;
+
+	// The fourth lane of a 3-float column is 0
+	[[nodiscard]] __m128 LoadColumn(const int index) const
+	requires(IS_ACCELERATED)
+	{
+		if constexpr (N == 4)
+		{
+			return _mm_load_ps(mColumns[index].begin());
+		}
+		else
+		{
+			return simd::float4::Load3(mColumns[index].begin());
+		}
+	}
+	void StoreColumn(const int index, const __m128 value)
+	requires(IS_ACCELERATED)
+	{
+		if constexpr (N == 4)
+		{
+			_mm_store_ps(mColumns[index].begin(), value);
+		}
+		else
+		{
+			simd::float4::Store3(mColumns[index].begin(), value);
+		}
+	}
+	[[nodiscard]] std::array<__m128, N> LoadColumns() const
+	requires(IS_ACCELERATED)
+	{
+		std::array<__m128, N> columns;
+		for (int i = 0; i < N; ++i)
+		{
+			columns[i] = LoadColumn(i);
+		}
+		return columns;
+	}
 private:
 	Column mColumns[N];
 };
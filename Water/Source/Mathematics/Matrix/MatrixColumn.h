@@ -1,4 +1,5 @@
 #pragma once
+#include "../Simd/Float4.h"
 
 template<class T, int N>
 requires(std::is_arithmetic_v<T>)
@@ -43,7 +44,9 @@ public:
 		return mData + N;
 	}
 private:
-	T mData[N];
+	// A 4-float column is aligned for SSE. A 3-float column stays tightly packed, so that the
+	// matrix can still be passed to OpenGL as it is.
+	alignas(simd::float4::IS_ACCELERATED<T, N> && N == 4 ? 16 : alignof(T)) T mData[N];
 };
 
 template<class T>
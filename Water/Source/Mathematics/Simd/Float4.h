@@ -0,0 +1,82 @@
+#pragma once
+#include <intrin.h>
+#include <array>
+#include <type_traits>
+
+// Helpers for the vectors and matrices of 3 and 4 floats, which keep their elements in the lanes
+// of one SSE register. They only use SSE2, which every x64 CPU supports, so unlike the batch
+// kernels they need no dispatch.
+namespace simd::float4
+{
+	// Whether "BasicVector<T, N>" and "BasicMatrix<T, N>" use the helpers
+	template<class T, int N>
+	inline constexpr bool IS_ACCELERATED = std::is_same_v<T, float> && (N == 3 || N == 4);
+
+	// Reads exactly 3 floats, so "source" does not need any padding. The fourth lane is 0.
+	inline __m128 Load3(const float* source)
+	{
+		return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)source), _mm_load_ss(source + 2));
+	}
+	// Writes exactly 3 floats
+	inline void Store3(float* destination, const __m128 value)
+	{
+		_mm_storel_pi((__m64*)destination, value);
+		_mm_store_ss(destination + 2, _mm_movehl_ps(value, value));
+	}
+
+	// Copies the lane "LANE" into every lane
+	template<int LANE>
+	__m128 Broadcast(const __m128 value)
+	{
+		return _mm_shuffle_ps(value, value, _MM_SHUFFLE(LANE, LANE, LANE, LANE));
+	}
+
+	// a * b + c. The project does not target FMA, so the multiplication gets rounded.
+	inline __m128 MulAdd(const __m128 a, const __m128 b, const __m128 c)
+	{
+		return _mm_add_ps(_mm_mul_ps(a, b), c);
+	}
+
+	// The dot product of the first N lanes. The products are summed in the same order as a
+	// scalar loop would, so the result is the same.
+	template<int N>
+	requires(N == 3 || N == 4)
+	float Dot(const __m128 a, const __m128 b)
+	{
+		const __m128 products = _mm_mul_ps(a, b);
+		__m128 sum = _mm_add_ss(products, Broadcast<1>(products));
+		sum = _mm_add_ss(sum, Broadcast<2>(products));
+		if constexpr (N == 4)
+		{
+			sum = _mm_add_ss(sum, Broadcast<3>(products));
+		}
+		return _mm_cvtss_f32(sum);
+	}
+
+	// The cross product of the first 3 lanes. The fourth lane is 0 if it is 0 in "a" or "b".
+	inline __m128 Cross(const __m128 a, const __m128 b)
+	{
+		// (y, z, x) * (z, x, y) - (z, x, y) * (y, z, x)
+		const __m128 aYzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 bZxy = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+		const __m128 aZxy = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+		const __m128 bYzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		return _mm_sub_ps(_mm_mul_ps(aYzx, bZxy), _mm_mul_ps(aZxy, bYzx));
+	}
+
+	// The sum of "columns[i] * coefficients[i]" for the first N lanes of "coefficients", i.e., a
+	// column-major matrix times a vector
+	template<int N>
+	requires(N == 3 || N == 4)
+	__m128 Transform(const std::array<__m128, N>& columns, const __m128 coefficients)
+	{
+		__m128 result = _mm_mul_ps(columns[0], Broadcast<0>(coefficients));
+		result = MulAdd(columns[1], Broadcast<1>(coefficients), result);
+		result = MulAdd(columns[2], Broadcast<2>(coefficients), result);
+		if constexpr (N == 4)
+		{
+			result = MulAdd(columns[3], Broadcast<3>(coefficients), result);
+		}
+		return result;
+	}
+}
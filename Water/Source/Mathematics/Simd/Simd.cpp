@@ -0,0 +1,56 @@
+#include "Simd.h"
+
+namespace
+{
+	simd::InstructionSet DetectInstructionSet()
+	{
+		int registers[4] = {};
+		__cpuid(registers, 0);
+		const int highestFunction = registers[0];
+
+		__cpuid(registers, 1);
+		const bool hasSse41 = registers[2] & (1 << 19);
+		const bool hasFma = registers[2] & (1 << 12);
+		const bool hasAvx = registers[2] & (1 << 28);
+		// The OS has to save the AVX registers on a context switch, which it signals through XCR0
+		const bool hasOsXsave = registers[2] & (1 << 27);
+		const bool osSavesAvxRegisters = hasOsXsave && (_xgetbv(0) & 0b110) == 0b110;
+
+		bool hasAvx2 = false;
+		if (highestFunction >= 7)
+		{
+			__cpuidex(registers, 7, 0);
+			hasAvx2 = registers[1] & (1 << 5);
+		}
+
+		if (hasAvx && hasAvx2 && hasFma && osSavesAvxRegisters)
+		{
+			return simd::InstructionSet::Avx2;
+		}
+		if (hasSse41)
+		{
+			return simd::InstructionSet::Sse41;
+		}
+		return simd::InstructionSet::Scalar;
+	}
+}
+
+simd::InstructionSet simd::GetInstructionSet()
+{
+	// Function-local statics are initialized in a thread-safe manner
+	static const InstructionSet instructionSet = DetectInstructionSet();
+	return instructionSet;
+}
+
+const char* simd::GetInstructionSetName(InstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+	case InstructionSet::Avx2:
+		return "AVX2";
+	case InstructionSet::Sse41:
+		return "SSE4.1";
+	default:
+		return "Scalar";
+	}
+}
@@ -0,0 +1,180 @@
+#pragma once
+#include <intrin.h>
+
+// Thin wrappers around the SIMD instruction sets, which let a kernel be written once as a
+// template and then get instantiated for every instruction set. Every wrapper processes
+// "WIDTH" lanes at a time and exposes the same set of static functions.
+namespace simd
+{
+	enum class InstructionSet
+	{
+		Scalar,
+		Sse41,
+		Avx2
+	};
+
+	// Thread-safe. The best instruction set that is supported by both the CPU and the OS.
+	// The detection only runs once.
+	InstructionSet GetInstructionSet();
+	const char* GetInstructionSetName(InstructionSet instructionSet);
+
+	// Processes a single lane, which makes it the fallback for CPUs without SSE4.1 and the
+	// tail of a batch whose size is not a multiple of the wider instruction sets' width
+	struct Scalar
+	{
+		static constexpr size_t WIDTH = 1;
+		using Float = float;
+		using Int = int;
+
+		static Float Load(const float* source) { return *source; }
+		static void Store(float* destination, Float value) { *destination = value; }
+		static Float Set(float value) { return value; }
+		static Int SetInt(int value) { return value; }
+
+		static Float Add(Float a, Float b) { return a + b; }
+		static Float Sub(Float a, Float b) { return a - b; }
+		static Float Mul(Float a, Float b) { return a * b; }
+		static Float Div(Float a, Float b) { return a / b; }
+		// a * b + c
+		static Float MulAdd(Float a, Float b, Float c) { return a * b + c; }
+		static Float Floor(Float value) { return std::floor(value); }
+		static Float Abs(Float value) { return std::abs(value); }
+		static Float Max(Float a, Float b) { return std::max(a, b); }
+		static Float Min(Float a, Float b) { return std::min(a, b); }
+		static Float Sqrt(Float value) { return std::sqrt(value); }
+		// "value" has to be a whole number
+		static Int ToInt(Float value) { return (int)value; }
+		static Float ToFloat(Int value) { return (float)value; }
+
+		static Int AddInt(Int a, Int b) { return a + b; }
+		static Int SubInt(Int a, Int b) { return a - b; }
+		static Int AndInt(Int a, Int b) { return a & b; }
+		static Int XorInt(Int a, Int b) { return a ^ b; }
+		// Keeps the low 32 bits of the product, which wraps around like unsigned integers do
+		static Int MulInt(Int a, Int b) { return (int)((unsigned int)a * (unsigned int)b); }
+		static Int ShiftRightInt(Int value, int count) { return value >> count; }
+		// Shifts in zeros, instead of copies of the sign bit
+		static Int ShiftRightLogicalInt(Int value, int count) { return (int)((unsigned int)value >> count); }
+
+		// The comparisons return a mask, which is -1 (all bits set) where the comparison holds and 0 elsewhere
+		static Int LessThan(Float a, Float b) { return a < b ? -1 : 0; }
+		static Int LessThanInt(Int a, Int b) { return a < b ? -1 : 0; }
+		static Int Equal(Float a, Float b) { return a == b ? -1 : 0; }
+		// Picks "a" where "mask" is -1 and "b" where it is 0
+		static Float Select(Int mask, Float a, Float b) { return mask ? a : b; }
+
+		static Int Gather(const int* base, Int indices) { return base[indices]; }
+		static Float Gather(const float* base, Int indices) { return base[indices]; }
+	};
+
+	struct Sse41
+	{
+		static constexpr size_t WIDTH = 4;
+		using Float = __m128;
+		using Int = __m128i;
+
+		static Float Load(const float* source) { return _mm_loadu_ps(source); }
+		static void Store(float* destination, Float value) { _mm_storeu_ps(destination, value); }
+		static Float Set(float value) { return _mm_set1_ps(value); }
+		static Int SetInt(int value) { return _mm_set1_epi32(value); }
+
+		static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+		static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+		static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+		static Float Div(Float a, Float b) { return _mm_div_ps(a, b); }
+		// SSE4.1 has no fused multiply-add
+		static Float MulAdd(Float a, Float b, Float c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+		static Float Floor(Float value) { return _mm_floor_ps(value); }
+		// Clears the sign bit
+		static Float Abs(Float value) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+		static Float Max(Float a, Float b) { return _mm_max_ps(a, b); }
+		static Float Min(Float a, Float b) { return _mm_min_ps(a, b); }
+		static Float Sqrt(Float value) { return _mm_sqrt_ps(value); }
+		static Int ToInt(Float value) { return _mm_cvttps_epi32(value); }
+		static Float ToFloat(Int value) { return _mm_cvtepi32_ps(value); }
+
+		static Int AddInt(Int a, Int b) { return _mm_add_epi32(a, b); }
+		static Int SubInt(Int a, Int b) { return _mm_sub_epi32(a, b); }
+		static Int AndInt(Int a, Int b) { return _mm_and_si128(a, b); }
+		static Int XorInt(Int a, Int b) { return _mm_xor_si128(a, b); }
+		static Int MulInt(Int a, Int b) { return _mm_mullo_epi32(a, b); }
+		static Int ShiftRightInt(Int value, int count) { return _mm_srai_epi32(value, count); }
+		static Int ShiftRightLogicalInt(Int value, int count) { return _mm_srli_epi32(value, count); }
+
+		static Int LessThan(Float a, Float b) { return _mm_castps_si128(_mm_cmplt_ps(a, b)); }
+		static Int LessThanInt(Int a, Int b) { return _mm_cmplt_epi32(a, b); }
+		static Int Equal(Float a, Float b) { return _mm_castps_si128(_mm_cmpeq_ps(a, b)); }
+		// Only the sign bit of every lane of "mask" is read
+		static Float Select(Int mask, Float a, Float b) { return _mm_blendv_ps(b, a, _mm_castsi128_ps(mask)); }
+
+		// SSE has no gather instruction, so the lanes are loaded one by one
+		static Int Gather(const int* base, Int indices)
+		{
+			return _mm_setr_epi32(base[_mm_extract_epi32(indices, 0)], base[_mm_extract_epi32(indices, 1)],
+								  base[_mm_extract_epi32(indices, 2)], base[_mm_extract_epi32(indices, 3)]);
+		}
+		static Float Gather(const float* base, Int indices)
+		{
+			return _mm_setr_ps(base[_mm_extract_epi32(indices, 0)], base[_mm_extract_epi32(indices, 1)],
+							   base[_mm_extract_epi32(indices, 2)], base[_mm_extract_epi32(indices, 3)]);
+		}
+	};
+
+	// Also requires FMA, which every CPU with AVX2 supports in practice
+	struct Avx2
+	{
+		static constexpr size_t WIDTH = 8;
+		using Float = __m256;
+		using Int = __m256i;
+
+		static Float Load(const float* source) { return _mm256_loadu_ps(source); }
+		static void Store(float* destination, Float value) { _mm256_storeu_ps(destination, value); }
+		static Float Set(float value) { return _mm256_set1_ps(value); }
+		static Int SetInt(int value) { return _mm256_set1_epi32(value); }
+
+		static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+		static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+		static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+		static Float Div(Float a, Float b) { return _mm256_div_ps(a, b); }
+		static Float MulAdd(Float a, Float b, Float c) { return _mm256_fmadd_ps(a, b, c); }
+		static Float Floor(Float value) { return _mm256_floor_ps(value); }
+		static Float Abs(Float value) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value); }
+		static Float Max(Float a, Float b) { return _mm256_max_ps(a, b); }
+		static Float Min(Float a, Float b) { return _mm256_min_ps(a, b); }
+		static Float Sqrt(Float value) { return _mm256_sqrt_ps(value); }
+		static Int ToInt(Float value) { return _mm256_cvttps_epi32(value); }
+		static Float ToFloat(Int value) { return _mm256_cvtepi32_ps(value); }
+
+		static Int AddInt(Int a, Int b) { return _mm256_add_epi32(a, b); }
+		static Int SubInt(Int a, Int b) { return _mm256_sub_epi32(a, b); }
+		static Int AndInt(Int a, Int b) { return _mm256_and_si256(a, b); }
+		static Int XorInt(Int a, Int b) { return _mm256_xor_si256(a, b); }
+		static Int MulInt(Int a, Int b) { return _mm256_mullo_epi32(a, b); }
+		static Int ShiftRightInt(Int value, int count) { return _mm256_srai_epi32(value, count); }
+		static Int ShiftRightLogicalInt(Int value, int count) { return _mm256_srli_epi32(value, count); }
+
+		static Int LessThan(Float a, Float b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+		// AVX2 only has a greater-than comparison for integers
+		static Int LessThanInt(Int a, Int b) { return _mm256_cmpgt_epi32(b, a); }
+		static Int Equal(Float a, Float b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+		static Float Select(Int mask, Float a, Float b) { return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(mask)); }
+
+		static Int Gather(const int* base, Int indices) { return _mm256_i32gather_epi32(base, indices, 4); }
+		static Float Gather(const float* base, Int indices) { return _mm256_i32gather_ps(base, indices, 4); }
+	};
+
+	// Calls "function" with the wrapper of the best supported instruction set, e.g., "function(simd::Avx2{})"
+	template<class FunctionT>
+	decltype(auto) Dispatch(FunctionT&& function)
+	{
+		switch (GetInstructionSet())
+		{
+		case InstructionSet::Avx2:
+			return function(Avx2{});
+		case InstructionSet::Sse41:
+			return function(Sse41{});
+		default:
+			return function(Scalar{});
+		}
+	}
+}
@@ -124,4 +124,68 @@ struct RawVector<T, 4> : public ContainerBase<T>
 	T y = (T)0;
 	T z = (T)0;
 	T w = (T)0;
-};
\ No newline at end of file
+};
+
+// The float vectors of 3 and 4 elements are loaded and stored as a whole SSE register, which is
+// fastest when the elements are aligned to 16 bytes. The 3-element vector therefore gets a fourth,
+// unused element, so that it can be loaded without reading past its end.
+template<>
+struct RawVector<float, 3> : public ContainerBase<float>
+{
+	RawVector(float x, float y, float z)
+		:
+		x(x),
+		y(y),
+		z(z)
+	{}
+	RawVector() = default;
+
+	float* GetPointerToData()
+	{
+		return &x;
+	}
+	const float* GetPointerToData() const
+	{
+		return &x;
+	}
+	std::string GetString() const
+	{
+		return "x: " + std::to_string(x) + " y: " + std::to_string(y) + " z: " + std::to_string(z);
+	}
+	alignas(16) float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+	// Unused. Holds whatever the last SSE operation left in the fourth lane. It is public, since
+	// mixing the access of the members would stop the vector from having a standard layout.
+	float padding = 0.0f;
+};
+
+template<>
+struct RawVector<float, 4> : public ContainerBase<float>
+{
+	RawVector(float x, float y, float z, float w)
+		:
+		x(x),
+		y(y),
+		z(z),
+		w(w)
+	{}
+	RawVector() = default;
+
+	float* GetPointerToData()
+	{
+		return &x;
+	}
+	const float* GetPointerToData() const
+	{
+		return &x;
+	}
+	std::string GetString() const
+	{
+		return "x: " + std::to_string(x) + " y: " + std::to_string(y) + " z: " + std::to_string(z) + " w: " + std::to_string(w);
+	}
+	alignas(16) float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+	float w = 0.0f;
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include "RawVector.h"
+#include "../Simd/Float4.h"
 #include "Source/Iterator/RandomAccessIterator.h"
+#include "Source/Iterator/IteratorMacro.h"
 
 template<class T, int N>
 requires (N >= 2 && std::is_arithmetic_v<T>)
@@ -24,12 +26,18 @@ public:
 	{
 		Base::InitializeContainerDebugInfo(Base::GetPointerToData(), Base::GetPointerToData() + N);
 	}
+#if ENABLE_ITERATOR_ERROR_CHECKING
 	BasicVector(const BasicVector& other)
 		:
 		Base(other)
 	{
 		Base::InitializeContainerDebugInfo(Base::GetPointerToData(), Base::GetPointerToData() + N);
 	}
+#else
+	// There is no container info to initialize, which keeps the vector trivially copyable
+	BasicVector(const BasicVector& other) = default;
+	BasicVector& operator=(const BasicVector& other) = default;
+#endif
 	template<class TOther>
 	explicit BasicVector(const BasicVector<TOther, N>& other)
 	{
@@ -76,12 +84,7 @@ public:
 
 	[[nodiscard]] T GetLengthSquared() const
 	{
-		T lengthSquared = (T)0;
-		for (int i = 0; i < N; ++i)
-		{
-			lengthSquared += (T)pow((double)(*this)[i], 2.0);
-		}
-		return lengthSquared;
+		return Dot(*this);
 	}
 	[[nodiscard]] T GetLength() const
 	{
@@ -89,20 +92,26 @@ public:
 	}
 	void Normalize()
 	{
-		T length = GetLength();
+		const T length = GetLength();
 		// Avoid division with 0
 		if (length != (T)0)
 		{
-			(*this) /= GetLength();
+			(*this) /= length;
 		}
 	}
-	[[nodiscard]] BasicVector GetNormalized()
+	[[nodiscard]] BasicVector GetNormalized() const
 	{
 		BasicVector temporary = *this;
-		return temporary.Normalize();
+		temporary.Normalize();
+		return temporary;
 	}
 	[[nodiscard]] T Dot(const BasicVector& other) const
 	{
+		if constexpr (IS_ACCELERATED)
+		{
+			return simd::float4::Dot<N>(Load(), other.Load());
+		}
+
 		T dot = (T)0;
 		for (int i = 0; i < N; ++i)
 		{
@@ -114,6 +123,13 @@ public:
 	{
 		static_assert(N == 3,
 			"You only cross vectors of size 3");
+		if constexpr (IS_ACCELERATED)
+		{
+			BasicVector cross;
+			cross.Store(simd::float4::Cross(Load(), other.Load()));
+			return cross;
+		}
+
 		const Base& otherBase = other;
 		return BasicVector(Base::y * otherBase.z - Base::z * otherBase.y,
 						   Base::z * otherBase.x - Base::x * otherBase.z,
@@ -122,6 +138,12 @@ public:
 
 	BasicVector& operator+=(const BasicVector& other)
 	{
+		if constexpr (IS_ACCELERATED)
+		{
+			Store(_mm_add_ps(Load(), other.Load()));
+			return *this;
+		}
+
 		for (int i = 0; i < N; ++i)
 		{
 			(*this)[i] += other[i];
@@ -130,6 +152,12 @@ public:
 	}
 	BasicVector& operator-=(const BasicVector& other)
 	{
+		if constexpr (IS_ACCELERATED)
+		{
+			Store(_mm_sub_ps(Load(), other.Load()));
+			return *this;
+		}
+
 		for (int i = 0; i < N; ++i)
 		{
 			(*this)[i] -= other[i];
@@ -138,6 +166,12 @@ public:
 	}
 	BasicVector& operator*=(const T value)
 	{
+		if constexpr (IS_ACCELERATED)
+		{
+			Store(_mm_mul_ps(Load(), _mm_set1_ps(value)));
+			return *this;
+		}
+
 		for (int i = 0; i < N; ++i)
 		{
 			(*this)[i] *= value;
@@ -146,6 +180,12 @@ public:
 	}
 	BasicVector& operator/=(const T value)
 	{
+		if constexpr (IS_ACCELERATED)
+		{
+			Store(_mm_div_ps(Load(), _mm_set1_ps(value)));
+			return *this;
+		}
+
 		for (int i = 0; i < N; ++i)
 		{
 			(*this)[i] /= value;
@@ -177,6 +217,20 @@ public:
 		temporary /= value;
 		return temporary;
 	}
+
+	// Whether the vector is stored as, and calculated with, a single SSE register
+	static constexpr bool IS_ACCELERATED = simd::float4::IS_ACCELERATED<T, N>;
+	// Loads all of the elements into one SSE register. The fourth lane of a 3-element vector is unused.
+	[[nodiscard]] __m128 Load() const
+	requires(IS_ACCELERATED)
+	{
+		return _mm_load_ps(Base::GetPointerToData());
+	}
+	void Store(const __m128 value)
+	requires(IS_ACCELERATED)
+	{
+		_mm_store_ps(Base::GetPointerToData(), value);
+	}
 private:
 	using Base = RawVector<T, N>;
 };
@@ -204,6 +258,17 @@ using Vector2i = BasicVector2<int>;
 using Vector3i = BasicVector3<int>;
 using Vector4i = BasicVector4<int>;
 
+#if !ENABLE_ITERATOR_ERROR_CHECKING
+// Without the container info, the vectors can be copied with "memcpy", e.g., into OpenGL buffers,
+// and the compiler can vectorize loops over arrays of them
+template<class T>
+concept PlainVector = std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>;
+static_assert(PlainVector<Vector2> && PlainVector<Vector3> && PlainVector<Vector4>);
+static_assert(PlainVector<Vector2i> && PlainVector<Vector3i> && PlainVector<Vector4i>);
+// Only the 3-element float vector is padded, so that it fills an SSE register
+static_assert(sizeof(Vector2) == 2 * sizeof(float) && sizeof(Vector3) == 4 * sizeof(float) && sizeof(Vector4) == 4 * sizeof(float));
+#endif
+
 namespace vector
 {
 	inline Vector3 up(0.0f, 1.0f, 0.0f);
@@ -0,0 +1,385 @@
+#pragma once
+#include "Vector.h"
+#include "../Matrix/Matrix.h"
+#include "../Simd/Simd.h"
+#include <array>
+#include <limits>
+#include <new>
+#include <span>
+#include <utility>
+
+// A batch of N-dimensional vectors, stored as a structure of arrays, i.e., one lane per dimension
+// that holds, e.g., all of the x-coordinates after each other. The kernels process the lanes a whole
+// register at a time, with the widest instruction set that the CPU supports, and give the same
+// results as the corresponding operations of "BasicVector" and "BasicMatrix". The kernels use the
+// SIMD wrappers, which only support floats.
+template<class T, int N>
+requires(N >= 2 && std::is_arithmetic_v<T>)
+class VectorBatch
+{
+public:
+	// Every lane starts at a cache line and is padded to whole cache lines, which are whole
+	// registers for every instruction set. The kernels that only write to the lanes therefore
+	// need no scalar tail.
+	static constexpr size_t ALIGNMENT = 64;
+
+	VectorBatch() = default;
+	// Contains "size" zero vectors
+	explicit VectorBatch(const size_t size)
+	{
+		Allocate(size);
+	}
+	explicit VectorBatch(std::span<const BasicVector<T, N>> vectors)
+		:
+		VectorBatch(vectors.size())
+	{
+		for (size_t i = 0; i < vectors.size(); ++i)
+		{
+			Set(i, vectors[i]);
+		}
+	}
+	VectorBatch(const VectorBatch& other)
+	{
+		*this = other;
+	}
+	VectorBatch& operator=(const VectorBatch& other)
+	{
+		if (this != &other)
+		{
+			Allocate(other.mSize);
+			std::copy(other.mValues.get(), other.mValues.get() + N * mPaddedSize, mValues.get());
+		}
+		return *this;
+	}
+	VectorBatch(VectorBatch&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+	VectorBatch& operator=(VectorBatch&& other) noexcept
+	{
+		mValues = std::move(other.mValues);
+		mSize = std::exchange(other.mSize, 0);
+		mPaddedSize = std::exchange(other.mPaddedSize, 0);
+		return *this;
+	}
+
+	[[nodiscard]] size_t Size() const
+	{
+		return mSize;
+	}
+	// Keeps the first "size" vectors, and fills the rest with zero vectors
+	void Resize(const size_t size)
+	{
+		VectorBatch resized(size);
+		const size_t keptSize = std::min(size, mSize);
+		for (int i = 0; i < N; ++i)
+		{
+			std::copy(GetLanePointer(i), GetLanePointer(i) + keptSize, resized.GetLanePointer(i));
+		}
+		*this = std::move(resized);
+	}
+
+	// The elements of every vector along the dimension "dimension"
+	[[nodiscard]] std::span<T> GetLane(const int dimension)
+	{
+		assert(dimension >= 0 && dimension < N);
+		return { GetLanePointer(dimension), mSize };
+	}
+	[[nodiscard]] std::span<const T> GetLane(const int dimension) const
+	{
+		assert(dimension >= 0 && dimension < N);
+		return { GetLanePointer(dimension), mSize };
+	}
+
+	[[nodiscard]] BasicVector<T, N> Get(const size_t index) const
+	{
+		assert(index < mSize);
+		BasicVector<T, N> vector;
+		for (int i = 0; i < N; ++i)
+		{
+			vector[i] = GetLanePointer(i)[index];
+		}
+		return vector;
+	}
+	void Set(const size_t index, const BasicVector<T, N>& vector)
+	{
+		assert(index < mSize);
+		for (int i = 0; i < N; ++i)
+		{
+			GetLanePointer(i)[index] = vector[i];
+		}
+	}
+	// Copies the batch back into an array of structures, which needs to have the same size
+	void CopyTo(std::span<BasicVector<T, N>> vectors) const
+	{
+		assert(vectors.size() == mSize);
+		for (size_t i = 0; i < mSize; ++i)
+		{
+			vectors[i] = Get(i);
+		}
+	}
+
+	VectorBatch& operator+=(const VectorBatch& other)
+	requires(std::is_same_v<T, float>)
+	{
+		ApplyElementWise(other, [](auto simd, auto a, auto b) { return decltype(simd)::Add(a, b); });
+		return *this;
+	}
+	VectorBatch& operator-=(const VectorBatch& other)
+	requires(std::is_same_v<T, float>)
+	{
+		ApplyElementWise(other, [](auto simd, auto a, auto b) { return decltype(simd)::Sub(a, b); });
+		return *this;
+	}
+	// Adds "vector" to every vector of the batch, e.g., to translate a set of points
+	VectorBatch& operator+=(const BasicVector<T, N>& vector)
+	requires(std::is_same_v<T, float>)
+	{
+		ApplyElementWise(vector, [](auto simd, auto a, auto b) { return decltype(simd)::Add(a, b); });
+		return *this;
+	}
+	VectorBatch& operator*=(const T value)
+	requires(std::is_same_v<T, float>)
+	{
+		ApplyElementWise(CreateFilledVector(value), [](auto simd, auto a, auto b) { return decltype(simd)::Mul(a, b); });
+		return *this;
+	}
+	VectorBatch& operator/=(const T value)
+	requires(std::is_same_v<T, float>)
+	{
+		ApplyElementWise(CreateFilledVector(value), [](auto simd, auto a, auto b) { return decltype(simd)::Div(a, b); });
+		return *this;
+	}
+
+	// Stores the dot product of every pair of vectors in "out", which needs to have the same size as the batches
+	void Dot(const VectorBatch& other, std::span<T> out) const
+	requires(std::is_same_v<T, float>)
+	{
+		assert(other.mSize == mSize && out.size() == mSize);
+		ForEachRegister(mSize, [&]<class Simd>(Simd, const size_t i)
+			{
+				Simd::Store(out.data() + i, Dot<Simd>(LoadVector<Simd>(i), other.LoadVector<Simd>(i)));
+			});
+	}
+	// Stores the length of every vector in "out", which needs to have the same size as the batch
+	void GetLengths(std::span<T> out) const
+	requires(std::is_same_v<T, float>)
+	{
+		assert(out.size() == mSize);
+		ForEachRegister(mSize, [&]<class Simd>(Simd, const size_t i)
+			{
+				const std::array<typename Simd::Float, N> vector = LoadVector<Simd>(i);
+				Simd::Store(out.data() + i, Simd::Sqrt(Dot<Simd>(vector, vector)));
+			});
+	}
+	// Vectors with a length of 0 are left unchanged, like in "BasicVector::Normalize"
+	void Normalize()
+	requires(std::is_same_v<T, float>)
+	{
+		ForEachRegister(mPaddedSize, [&]<class Simd>(Simd, const size_t i)
+			{
+				const std::array<typename Simd::Float, N> vector = LoadVector<Simd>(i);
+				const typename Simd::Float length = Simd::Sqrt(Dot<Simd>(vector, vector));
+				// Every lane gets divided, and the lanes that were divided by 0 are then replaced, instead of branching
+				const typename Simd::Int isZeroLength = Simd::Equal(length, Simd::Set(0.0f));
+				for (int j = 0; j < N; ++j)
+				{
+					Simd::Store(GetLanePointer(j) + i, Simd::Select(isZeroLength, vector[j], Simd::Div(vector[j], length)));
+				}
+			});
+	}
+	// Replaces every vector with "matrix * vector"
+	void Transform(const BasicMatrix<T, N>& matrix)
+	requires(std::is_same_v<T, float>)
+	{
+		ForEachRegister(mPaddedSize, [&]<class Simd>(Simd, const size_t i)
+			{
+				const std::array<typename Simd::Float, N> vector = LoadVector<Simd>(i);
+				for (int y = 0; y < N; ++y)
+				{
+					// Sums the products in the same order as "BasicMatrix", so the result is the same
+					typename Simd::Float value = Simd::Mul(Simd::Set(matrix[0][y]), vector[0]);
+					for (int x = 1; x < N; ++x)
+					{
+						value = Simd::Add(value, Simd::Mul(Simd::Set(matrix[x][y]), vector[x]));
+					}
+					Simd::Store(GetLanePointer(y) + i, value);
+				}
+			});
+	}
+
+	// The reductions sum up the lanes in a different order than a loop over the vectors
+	// would, so a sum may differ in its last bits
+	[[nodiscard]] BasicVector<T, N> GetSum() const
+	requires(std::is_same_v<T, float>)
+	{
+		return Reduce(0.0f, [](auto simd, auto a, auto b) { return decltype(simd)::Add(a, b); });
+	}
+	// The smallest element along every dimension, e.g., the lower corner of a bounding box
+	[[nodiscard]] BasicVector<T, N> GetMinimum() const
+	requires(std::is_same_v<T, float>)
+	{
+		assert(mSize > 0);
+		return Reduce(std::numeric_limits<float>::max(), [](auto simd, auto a, auto b) { return decltype(simd)::Min(a, b); });
+	}
+	// The largest element along every dimension, e.g., the upper corner of a bounding box
+	[[nodiscard]] BasicVector<T, N> GetMaximum() const
+	requires(std::is_same_v<T, float>)
+	{
+		assert(mSize > 0);
+		return Reduce(std::numeric_limits<float>::lowest(), [](auto simd, auto a, auto b) { return decltype(simd)::Max(a, b); });
+	}
+private:
+	// The values are allocated with the alignment of the batch, so they need to be freed with it
+	struct AlignedDeleter
+	{
+		void operator()(T* values) const
+		{
+			::operator delete(values, std::align_val_t(ALIGNMENT));
+		}
+	};
+
+	static constexpr size_t VALUES_PER_ALIGNMENT = ALIGNMENT / sizeof(T);
+
+	// Allocates "size" zero vectors, which replace the current ones
+	void Allocate(const size_t size)
+	{
+		mSize = size;
+		mPaddedSize = (size + VALUES_PER_ALIGNMENT - 1) / VALUES_PER_ALIGNMENT * VALUES_PER_ALIGNMENT;
+		if (mPaddedSize == 0)
+		{
+			mValues.reset();
+			return;
+		}
+		mValues.reset((T*)::operator new(N * mPaddedSize * sizeof(T), std::align_val_t(ALIGNMENT)));
+		std::fill(mValues.get(), mValues.get() + N * mPaddedSize, (T)0);
+	}
+	[[nodiscard]] T* GetLanePointer(const int dimension)
+	{
+		return mValues.get() + dimension * mPaddedSize;
+	}
+	[[nodiscard]] const T* GetLanePointer(const int dimension) const
+	{
+		return mValues.get() + dimension * mPaddedSize;
+	}
+
+	// Calls "kernel(simd, i)" for every register in [0, end), where "i" is the index of the
+	// register's first vector. The vectors that do not fill a whole register are processed
+	// one by one.
+	template<class KernelT>
+	static void ForEachRegister(const size_t end, KernelT&& kernel)
+	{
+		auto processRange = [&]<class Simd>(Simd simd, const size_t rangeBegin, const size_t rangeEnd)
+		{
+			for (size_t i = rangeBegin; i < rangeEnd; i += Simd::WIDTH)
+			{
+				kernel(simd, i);
+			}
+		};
+
+		simd::Dispatch([&](auto simd)
+			{
+				const size_t batchEnd = end - end % decltype(simd)::WIDTH;
+				processRange(simd, 0, batchEnd);
+				processRange(simd::Scalar{}, batchEnd, end);
+			});
+	}
+	template<class Simd>
+	[[nodiscard]] std::array<typename Simd::Float, N> LoadVector(const size_t index) const
+	{
+		std::array<typename Simd::Float, N> vector;
+		for (int i = 0; i < N; ++i)
+		{
+			vector[i] = Simd::Load(GetLanePointer(i) + index);
+		}
+		return vector;
+	}
+	// Sums the products in the same order as "BasicVector::Dot", so the result is the same
+	template<class Simd>
+	[[nodiscard]] static typename Simd::Float Dot(const std::array<typename Simd::Float, N>& a, const std::array<typename Simd::Float, N>& b)
+	{
+		typename Simd::Float dot = Simd::Mul(a[0], b[0]);
+		for (int i = 1; i < N; ++i)
+		{
+			dot = Simd::Add(dot, Simd::Mul(a[i], b[i]));
+		}
+		return dot;
+	}
+
+	// Replaces every element with "operation(simd, element, other element)"
+	template<class OperationT>
+	void ApplyElementWise(const VectorBatch& other, OperationT&& operation)
+	{
+		assert(other.mSize == mSize);
+		ForEachRegister(mPaddedSize, [&]<class Simd>(Simd simd, const size_t i)
+			{
+				for (int j = 0; j < N; ++j)
+				{
+					T* lane = GetLanePointer(j);
+					Simd::Store(lane + i, operation(simd, Simd::Load(lane + i), Simd::Load(other.GetLanePointer(j) + i)));
+				}
+			});
+	}
+	// Replaces every element with "operation(simd, element, element of "vector" along the same dimension)"
+	template<class OperationT>
+	void ApplyElementWise(const BasicVector<T, N>& vector, OperationT&& operation)
+	{
+		ForEachRegister(mPaddedSize, [&]<class Simd>(Simd simd, const size_t i)
+			{
+				for (int j = 0; j < N; ++j)
+				{
+					T* lane = GetLanePointer(j);
+					Simd::Store(lane + i, operation(simd, Simd::Load(lane + i), Simd::Set(vector[j])));
+				}
+			});
+	}
+	static BasicVector<T, N> CreateFilledVector(const T value)
+	{
+		BasicVector<T, N> vector;
+		for (int i = 0; i < N; ++i)
+		{
+			vector[i] = value;
+		}
+		return vector;
+	}
+
+	// Combines all of the elements of every lane with "reduce(simd, a, b)". Only the first "mSize"
+	// elements are read, so the padding never affects the result.
+	template<class ReduceT>
+	[[nodiscard]] BasicVector<T, N> Reduce(const T identity, ReduceT&& reduce) const
+	{
+		BasicVector<T, N> result;
+		simd::Dispatch([&]<class Simd>(Simd simd)
+			{
+				const size_t batchEnd = mSize - mSize % Simd::WIDTH;
+				for (int i = 0; i < N; ++i)
+				{
+					const T* lane = GetLanePointer(i);
+					typename Simd::Float accumulator = Simd::Set(identity);
+					for (size_t j = 0; j < batchEnd; j += Simd::WIDTH)
+					{
+						accumulator = reduce(simd, accumulator, Simd::Load(lane + j));
+					}
+
+					std::array<T, Simd::WIDTH> lanes;
+					Simd::Store(lanes.data(), accumulator);
+					T value = identity;
+					for (const T laneValue : lanes)
+					{
+						value = reduce(simd::Scalar{}, value, laneValue);
+					}
+					for (size_t j = batchEnd; j < mSize; ++j)
+					{
+						value = reduce(simd::Scalar{}, value, lane[j]);
+					}
+					result[i] = value;
+				}
+			});
+		return result;
+	}
+private:
+	std::unique_ptr<T[], AlignedDeleter> mValues;
+	size_t mSize = 0;
+	// "mSize" rounded up to whole cache lines
+	size_t mPaddedSize = 0;
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "../Mathematics/Vector/Vector.h"
+#include "NoiseBatch.h"
+
+enum class FbmVariant
+{
+	// The octaves are summed as they are, which gives rolling hills or gentle waves
+	Standard,
+	// The absolute values of the octaves are summed, which creates creases where the noise crosses its midpoint
+	Turbulence,
+	// Inverted and squared turbulence, which turns the creases into sharp ridges, e.g., wave crests
+	Ridged
+};
+
+struct FbmSettings
+{
+	int octaveCount = 4;
+	// How much the frequency gets multiplied by for every octave
+	float lacunarity = 2.0f;
+	// How much the amplitude gets multiplied by for every octave
+	float gain = 0.5f;
+	FbmVariant variant = FbmVariant::Standard;
+};
+
+// Fractal Brownian motion, i.e., the sum of several octaves of "NoiseT" with increasing frequencies and
+// decreasing amplitudes. "NoiseT" is, e.g., "PerlinNoise<3>" and needs to return values between 0 and 1.
+// The sum is normalized, so "FbmNoise" also returns values between 0 and 1.
+template<class NoiseT>
+class FbmNoise
+{
+public:
+	static constexpr int DIMENSION = NoiseT::DIMENSION;
+
+	// Store the noise as a shared pointer so that several layers, e.g., a standard and a ridged one,
+	// can share the same noise and its tables
+	FbmNoise(const std::shared_ptr<const NoiseT> noise, const FbmSettings& settings)
+		:
+		mNoise(noise),
+		mVariant(settings.variant)
+	{
+		assert(settings.octaveCount > 0);
+
+		float frequency = 1.0f;
+		float amplitude = 1.0f;
+		float amplitudeSum = 0.0f;
+		for (int i = 0; i < settings.octaveCount; ++i)
+		{
+			mOctaves.push_back(Octave{ frequency, amplitude, (float)i * OCTAVE_OFFSET });
+			amplitudeSum += amplitude;
+
+			frequency *= settings.lacunarity;
+			amplitude *= settings.gain;
+		}
+
+		// Make the amplitudes add up to 1
+		for (Octave& octave : mOctaves)
+		{
+			octave.amplitude /= amplitudeSum;
+		}
+	}
+
+	float Get(const BasicVector<float, DIMENSION>& position) const
+	{
+		float sum = 0.0f;
+		for (const Octave& octave : mOctaves)
+		{
+			BasicVector<float, DIMENSION> octavePosition;
+			for (int i = 0; i < DIMENSION; ++i)
+			{
+				octavePosition[i] = position[i] * octave.frequency + octave.offset;
+			}
+			sum += Shape(mNoise->Get(octavePosition) * 2.0f - 1.0f) * octave.amplitude;
+		}
+		return mVariant == FbmVariant::Standard ? sum * 0.5f + 0.5f : sum;
+	}
+	// Evaluates "Get" for a batch of positions, using the widest instruction set that the CPU supports.
+	// All of the octaves are evaluated in a single pass over the positions.
+	void GetMany(const noise::Positions<DIMENSION>& positions, std::span<float> out) const
+	{
+		noise::EvaluateMany<DIMENSION>(*this, positions, out);
+	}
+	void GetMany(std::span<const float> xs, std::span<const float> ys, std::span<float> out) const
+	requires(DIMENSION == 2)
+	{
+		GetMany({ xs, ys }, out);
+	}
+	void GetMany(std::span<const float> xs, std::span<const float> ys, std::span<const float> zs, std::span<float> out) const
+	requires(DIMENSION == 3)
+	{
+		GetMany({ xs, ys, zs }, out);
+	}
+	// Evaluates "Simd::WIDTH" positions at once
+	template<class Simd>
+	typename Simd::Float Evaluate(const std::array<typename Simd::Float, DIMENSION>& position) const
+	{
+		// The variant is resolved once, instead of once per octave
+		switch (mVariant)
+		{
+		case FbmVariant::Turbulence:
+			return Sum<Simd, FbmVariant::Turbulence>(position);
+		case FbmVariant::Ridged:
+			return Sum<Simd, FbmVariant::Ridged>(position);
+		default:
+			return Simd::MulAdd(Sum<Simd, FbmVariant::Standard>(position), Simd::Set(0.5f), Simd::Set(0.5f));
+		}
+	}
+private:
+	struct Octave
+	{
+		float frequency = 1.0f;
+		float amplitude = 1.0f;
+		// Every octave gets shifted, so that the lattices of the octaves do not line up at the origin
+		float offset = 0.0f;
+	};
+
+	template<class Simd, FbmVariant VARIANT>
+	typename Simd::Float Sum(const std::array<typename Simd::Float, DIMENSION>& position) const
+	{
+		using Float = typename Simd::Float;
+
+		Float sum = Simd::Set(0.0f);
+		for (const Octave& octave : mOctaves)
+		{
+			std::array<Float, DIMENSION> octavePosition;
+			for (int i = 0; i < DIMENSION; ++i)
+			{
+				octavePosition[i] = Simd::MulAdd(position[i], Simd::Set(octave.frequency), Simd::Set(octave.offset));
+			}
+
+			// The noise ranges between 0 and 1, but the octaves are summed between -1 and 1
+			const Float signal = Simd::MulAdd(mNoise->template Evaluate<Simd>(octavePosition), Simd::Set(2.0f), Simd::Set(-1.0f));
+
+			Float shapedSignal = signal;
+			if constexpr (VARIANT == FbmVariant::Turbulence)
+			{
+				shapedSignal = Simd::Abs(signal);
+			}
+			else if constexpr (VARIANT == FbmVariant::Ridged)
+			{
+				const Float ridge = Simd::Sub(Simd::Set(1.0f), Simd::Abs(signal));
+				shapedSignal = Simd::Mul(ridge, ridge);
+			}
+			sum = Simd::MulAdd(shapedSignal, Simd::Set(octave.amplitude), sum);
+		}
+		return sum;
+	}
+	float Shape(float signal) const
+	{
+		switch (mVariant)
+		{
+		case FbmVariant::Turbulence:
+			return std::abs(signal);
+		case FbmVariant::Ridged:
+			return (1.0f - std::abs(signal)) * (1.0f - std::abs(signal));
+		default:
+			return signal;
+		}
+	}
+private:
+	static constexpr float OCTAVE_OFFSET = 19.19f;
+
+	std::shared_ptr<const NoiseT> mNoise;
+	FbmVariant mVariant;
+	std::vector<Octave> mOctaves;
+};
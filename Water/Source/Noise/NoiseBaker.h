@@ -0,0 +1,48 @@
+#pragma once
+#include "../Mathematics/Algorithms.h"
+#include "NoiseGradient.h"
+#include "../Threading/ThreadPool.h"
+
+namespace noise
+{
+	// Bakes one tile of "noise" into "resolution" ^ N texels, e.g., for a texture with repeat wrapping.
+	// The tile spans "period" units of the noise along every dimension, which is passed on to
+	// "noise.GetWithGradient", so that the noise repeats at the edges of the tile.
+	// Every texel holds N + 1 floats: the value at the texel's center, followed by the gradient per
+	// unit of the noise. The first dimension is the innermost one. The rows of texels are spread
+	// over the cores by the shared thread pool.
+	template<int N, class NoiseT>
+	std::vector<float> BakeTileable(const NoiseT& noise, const int resolution, const int period)
+	{
+		constexpr size_t TEXEL_SIZE = N + 1;
+		const size_t nRows = (size_t)Power(resolution, N - 1);
+		std::vector<float> texels(nRows * resolution * TEXEL_SIZE);
+
+		const float texelLength = (float)period / (float)resolution;
+		ThreadPool::GetShared().ParallelFor(nRows, [&](size_t row)
+			{
+				// The row's position along every dimension except the first one
+				BasicVector<float, N> position;
+				size_t remainingRow = row;
+				for (int i = 1; i < N; ++i)
+				{
+					position[i] = ((float)(remainingRow % resolution) + 0.5f) * texelLength;
+					remainingRow /= resolution;
+				}
+
+				float* texel = texels.data() + row * resolution * TEXEL_SIZE;
+				for (int x = 0; x < resolution; ++x)
+				{
+					position[0] = ((float)x + 0.5f) * texelLength;
+					const ValueWithGradient<N> valueWithGradient = noise.GetWithGradient(position, period);
+
+					*texel++ = valueWithGradient.value;
+					for (int i = 0; i < N; ++i)
+					{
+						*texel++ = valueWithGradient.gradient[i];
+					}
+				}
+			});
+		return texels;
+	}
+}
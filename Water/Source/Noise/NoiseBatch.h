@@ -0,0 +1,43 @@
+#pragma once
+#include <array>
+#include <span>
+#include "../Mathematics/Simd/Simd.h"
+
+namespace noise
+{
+	// A batch of positions, given as one span per dimension, e.g., "{ xs, ys, zs }"
+	template<int N>
+	using Positions = std::array<std::span<const float>, N>;
+
+	// Fills "out" with "noise.Evaluate<Simd>" for every position, using the widest instruction set that
+	// the CPU supports. The positions that do not fill a whole register are evaluated one by one.
+	// All of the spans need to have the same size.
+	template<int N, class NoiseT>
+	void EvaluateMany(const NoiseT& noise, const Positions<N>& positions, std::span<float> out)
+	{
+		for (const std::span<const float>& coordinates : positions)
+		{
+			assert(coordinates.size() == out.size());
+		}
+
+		auto evaluateRange = [&]<class Simd>(Simd, size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i += Simd::WIDTH)
+			{
+				std::array<typename Simd::Float, N> position;
+				for (int j = 0; j < N; ++j)
+				{
+					position[j] = Simd::Load(positions[j].data() + i);
+				}
+				Simd::Store(out.data() + i, noise.template Evaluate<Simd>(position));
+			}
+		};
+
+		simd::Dispatch([&](auto simd)
+			{
+				const size_t batchEnd = out.size() - out.size() % decltype(simd)::WIDTH;
+				evaluateRange(simd, 0, batchEnd);
+				evaluateRange(simd::Scalar{}, batchEnd, out.size());
+			});
+	}
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <array>
+#include <utility>
+#include "../Mathematics/Algorithms.h"
+
+// Helpers for the noise classes that interpolate between the 2 ^ N corners of the unit hypercube
+// that surrounds the sampled position, or that search the 3 ^ N cells around it. Everything is
+// generated and unrolled at compile time.
+namespace noise
+{
+	template<int N>
+	using CornerOffsets = std::array<std::array<int, N>, Power(2, N)>;
+
+	// The offsets from the floored position to every corner. The j-th element of the i-th corner is
+	// the j-th bit of i, so corner 2k and 2k + 1 only differ in the first element, which is the
+	// order that "InterpolateCorners" expects.
+	template<int N>
+	constexpr CornerOffsets<N> CreateCornerOffsets()
+	{
+		CornerOffsets<N> cornerOffsets = {};
+		for (size_t i = 0; i < cornerOffsets.size(); ++i)
+		{
+			for (int j = 0; j < N; ++j)
+			{
+				cornerOffsets[i][j] = (int)((i >> j) & 1);
+			}
+		}
+		return cornerOffsets;
+	}
+
+	template<int N>
+	using NeighbourOffsets = std::array<std::array<int, N>, Power(3, N)>;
+
+	// The offsets from a cell to its 3 ^ N neighbours, itself included. The i-th element of the j-th
+	// neighbour is "(j / 3 ^ i) % 3 - 1", which is the order that the hash policies' "GetBatchHashes"
+	// hashes three locations per dimension in.
+	template<int N>
+	constexpr NeighbourOffsets<N> CreateNeighbourOffsets()
+	{
+		NeighbourOffsets<N> neighbourOffsets = {};
+		for (size_t j = 0; j < neighbourOffsets.size(); ++j)
+		{
+			size_t remainingNeighbour = j;
+			for (int i = 0; i < N; ++i)
+			{
+				neighbourOffsets[j][i] = (int)(remainingNeighbour % 3) - 1;
+				remainingNeighbour /= 3;
+			}
+		}
+		return neighbourOffsets;
+	}
+
+	// Calls "function" once per index in [0, COUNT) with the index as a "std::integral_constant",
+	// which unrolls the loop and lets the function use the index at compile time
+	template<size_t COUNT, class FunctionT>
+	void ForEachIndex(FunctionT&& function)
+	{
+		[&]<size_t... INDICES>(std::index_sequence<INDICES...>)
+		{
+			(function(std::integral_constant<size_t, INDICES>{}), ...);
+		}(std::make_index_sequence<COUNT>{});
+	}
+	// Calls "function" once per corner with the index of the corner as a "std::integral_constant",
+	// which lets the function look up the corner's offset at compile time
+	template<int N, class FunctionT>
+	void ForEachCorner(FunctionT&& function)
+	{
+		ForEachIndex<Power(2, N)>(function);
+	}
+
+	// Interpolates the corner values down to a single value. The first amount interpolates between
+	// all of the corners that only differ in the first element, which halves the number of values,
+	// the second amount between the resulting values, and so on. "lerp(a, b, amount)" does the interpolation.
+	template<size_t DIMENSION = 0, class ValueT, size_t N_VALUES, class AmountT, size_t N, class LerpT>
+	ValueT InterpolateCorners(const std::array<ValueT, N_VALUES>& values, const std::array<AmountT, N>& amounts, const LerpT& lerp)
+	{
+		if constexpr (N_VALUES == 1)
+		{
+			return values[0];
+		}
+		else
+		{
+			const std::array<ValueT, N_VALUES / 2> interpolatedValues = [&]<size_t... PAIRS>(std::index_sequence<PAIRS...>)
+			{
+				return std::array<ValueT, N_VALUES / 2>{ lerp(values[2 * PAIRS], values[2 * PAIRS + 1], amounts[DIMENSION])... };
+			}(std::make_index_sequence<N_VALUES / 2>{});
+
+			return InterpolateCorners<DIMENSION + 1>(interpolatedValues, amounts, lerp);
+		}
+	}
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "../Mathematics/Vector/Vector.h"
+
+namespace noise
+{
+	// A noise value together with its analytic partial derivatives, i.e., "gradient[i]" is how
+	// much the value changes per unit along the i-th dimension
+	template<int N>
+	struct ValueWithGradient
+	{
+		float value = 0.0f;
+		BasicVector<float, N> gradient;
+	};
+}
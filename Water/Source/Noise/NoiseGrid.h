@@ -0,0 +1,163 @@
+#pragma once
+#include <array>
+#include <span>
+#include "../Mathematics/Simd/Simd.h"
+#include "../Threading/ThreadPool.h"
+
+namespace noise
+{
+	// Fills a 2D or 3D grid of samples with noise. The grid is split into tiles of about 16 KB, which
+	// fit into the L1 cache, and the tiles are evaluated on a thread pool with the batch kernel of
+	// the noise, i.e., "noise.Evaluate<Simd>".
+	template<int N>
+	requires(N == 2 || N == 3)
+	class NoiseGrid
+	{
+	public:
+		// The buffer and the strides need to be aligned to cache lines, so that no two tiles share
+		// a cache line and the rows start at a whole register
+		static constexpr size_t ALIGNMENT = 64;
+
+		// The grid has "size[i]" samples along the i-th dimension. The first sample is located at
+		// "origin" and the samples are "spacing" apart.
+		NoiseGrid(const std::array<int, N>& size, const std::array<float, N>& origin, const std::array<float, N>& spacing)
+			:
+			mSize(size),
+			mOrigin(origin),
+			mSpacing(spacing)
+		{
+			for (int i = 0; i < N; ++i)
+			{
+				assert(size[i] > 0);
+				mTileCounts[i] = (size[i] + TILE_SIZE[i] - 1) / TILE_SIZE[i];
+			}
+		}
+
+		// Stores the sample (x, y, z) at "out[x + y * rowStride + z * sliceStride]". The strides are
+		// given in floats. "out" needs to be aligned to "ALIGNMENT" bytes and the strides need to be
+		// multiples of "ALIGNMENT" bytes.
+		template<class NoiseT>
+		requires(NoiseT::DIMENSION == N)
+		void Generate(const NoiseT& noise, std::span<float> out, size_t rowStride, size_t sliceStride = 0,
+			ThreadPool& threadPool = ThreadPool::GetShared()) const
+		{
+			constexpr size_t FLOATS_PER_ALIGNMENT = ALIGNMENT / sizeof(float);
+			assert((uintptr_t)out.data() % ALIGNMENT == 0);
+			assert(rowStride % FLOATS_PER_ALIGNMENT == 0 && rowStride >= (size_t)mSize[0]);
+			if constexpr (N == 3)
+			{
+				assert(sliceStride % FLOATS_PER_ALIGNMENT == 0 && sliceStride >= rowStride * mSize[1]);
+			}
+			const std::array<size_t, N> strides = GetStrides(rowStride, sliceStride);
+			size_t lastSampleIndex = 0;
+			for (int i = 0; i < N; ++i)
+			{
+				lastSampleIndex += (size_t)(mSize[i] - 1) * strides[i];
+			}
+			assert(lastSampleIndex < out.size());
+
+			size_t tileCount = 1;
+			for (int i = 0; i < N; ++i)
+			{
+				tileCount *= (size_t)mTileCounts[i];
+			}
+
+			simd::Dispatch([&](auto simd)
+				{
+					threadPool.ParallelFor(tileCount, [&](size_t tileIndex)
+						{
+							GenerateTile<decltype(simd)>(noise, tileIndex, out.data(), strides);
+						});
+				});
+		}
+	private:
+		template<class Simd, class NoiseT>
+		void GenerateTile(const NoiseT& noise, size_t tileIndex, float* out, const std::array<size_t, N>& strides) const
+		{
+			// The first and the last sample of the tile, along every dimension
+			std::array<int, N> begin;
+			std::array<int, N> end;
+			for (int i = 0; i < N; ++i)
+			{
+				begin[i] = (int)(tileIndex % mTileCounts[i]) * TILE_SIZE[i];
+				end[i] = std::min(begin[i] + TILE_SIZE[i], mSize[i]);
+				tileIndex /= mTileCounts[i];
+			}
+
+			// The positions along the rows are the same for every row of the tile
+			alignas(ALIGNMENT) std::array<float, TILE_SIZE[0]> xs;
+			for (int x = begin[0]; x < end[0]; ++x)
+			{
+				xs[x - begin[0]] = mOrigin[0] + (float)x * mSpacing[0];
+			}
+			const int rowLength = end[0] - begin[0];
+			const int batchLength = rowLength - rowLength % (int)Simd::WIDTH;
+
+			const int depthBegin = N == 3 ? begin[N - 1] : 0;
+			const int depthEnd = N == 3 ? end[N - 1] : 1;
+			for (int z = depthBegin; z < depthEnd; ++z)
+			{
+				for (int y = begin[1]; y < end[1]; ++y)
+				{
+					float* row = out + begin[0] + y * strides[1];
+					std::array<float, N> rowPosition;
+					rowPosition[1] = mOrigin[1] + (float)y * mSpacing[1];
+					if constexpr (N == 3)
+					{
+						row += z * strides[2];
+						rowPosition[2] = mOrigin[2] + (float)z * mSpacing[2];
+					}
+
+					EvaluateRow<Simd>(noise, xs.data(), rowPosition, 0, batchLength, row);
+					// The samples that do not fill a whole register
+					EvaluateRow<simd::Scalar>(noise, xs.data(), rowPosition, batchLength, rowLength, row);
+				}
+			}
+		}
+		template<class Simd, class NoiseT>
+		static void EvaluateRow(const NoiseT& noise, const float* xs, const std::array<float, N>& rowPosition, int begin, int end, float* row)
+		{
+			std::array<typename Simd::Float, N> position;
+			for (int i = 1; i < N; ++i)
+			{
+				position[i] = Simd::Set(rowPosition[i]);
+			}
+			for (int x = begin; x < end; x += (int)Simd::WIDTH)
+			{
+				position[0] = Simd::Load(xs + x);
+				Simd::Store(row + x, noise.template Evaluate<Simd>(position));
+			}
+		}
+		static std::array<size_t, N> GetStrides(size_t rowStride, size_t sliceStride)
+		{
+			if constexpr (N == 2)
+			{
+				return { 1, rowStride };
+			}
+			else
+			{
+				return { 1, rowStride, sliceStride };
+			}
+		}
+	private:
+		// 4096 samples per tile, i.e., 16 KB of output. The rows are kept long, since the batch
+		// kernel evaluates whole registers along them.
+		static constexpr std::array<int, N> TILE_SIZE = []()
+		{
+			if constexpr (N == 2)
+			{
+				return std::array<int, N>{ 64, 64 };
+			}
+			else
+			{
+				return std::array<int, N>{ 32, 16, 8 };
+			}
+		}();
+
+		std::array<int, N> mSize;
+		std::array<float, N> mOrigin;
+		std::array<float, N> mSpacing;
+		// The number of tiles along every dimension
+		std::array<int, N> mTileCounts;
+	};
+}
@@ -0,0 +1,190 @@
+#pragma once
+#include <array>
+#include "../Mathematics/Algorithms.h"
+#include "../Mathematics/Simd/Simd.h"
+#include "PermutationTable.h"
+#include "NoiseCorners.h"
+
+// The policies that "PerlinNoise", "SimplexNoise" and "ValueNoise" hash the corners of the lattice with.
+// Every policy turns a location, whose elements are wrapped to [0, N_RANDOM_VALUES), into a
+// random index in [0, N_RANDOM_VALUES).
+//
+// The batch kernels hash all of the corners at once with "GetBatchHashes", which returns
+// "batch hashes" in [0, BATCH_HASH_COUNT) instead. "GetRandomIndexOfBatchHash" turns them into
+// random indices, which lets the noise classes fold that last step into their own lookup tables.
+// "GetBatchHashes" takes "N_OFFSETS" wrapped locations per dimension and hashes every combination
+// of them, i.e., the 2 ^ N corners of a cell or, e.g., the 3 ^ N cells around a cell. The j-th
+// combination uses the location "(j / N_OFFSETS ^ i) % N_OFFSETS" along the i-th dimension.
+namespace noise
+{
+	// Spreads every bit of "value" over all of the bits (the "lowbias32" mixer by Chris Wellons)
+	constexpr uint32_t MixBits(uint32_t value)
+	{
+		value ^= value >> 16;
+		value *= 0x7FEB352D;
+		value ^= value >> 15;
+		value *= 0x846CA68B;
+		value ^= value >> 16;
+		return value;
+	}
+
+	// Chains one lookup into the permutation table per dimension. Every lookup depends on the
+	// previous one, so the latency of the loads adds up.
+	template<int N_RANDOM_VALUES>
+	class PermutationHash
+	{
+	public:
+		static constexpr size_t BATCH_HASH_COUNT = N_RANDOM_VALUES * 2 - 1;
+
+		PermutationHash(const std::shared_ptr<const PermutationTable<N_RANDOM_VALUES>> permutationTable)
+			:
+			mPermutationTable(permutationTable)
+		{
+			// The gather instructions need 32-bit indices
+			for (size_t i = 0; i < mBatchPermutationTable.size(); ++i)
+			{
+				mBatchPermutationTable[i] = (int)(*mPermutationTable)[i];
+			}
+		}
+
+		template<int N>
+		size_t GetRandomIndex(const std::array<int, N>& location) const
+		{
+			size_t index = 0;
+			// Combine all of the location's elements into one index, effectively
+			// hashing the location
+			for (int i = 0; i < N; ++i)
+			{
+				index = (*mPermutationTable)[location[i] + index];
+			}
+
+			return index;
+		}
+		// The last lookup of "GetRandomIndex" is left out
+		template<class Simd, int N, size_t N_OFFSETS = 2>
+		std::array<typename Simd::Int, Power(N_OFFSETS, N)> GetBatchHashes(const std::array<std::array<typename Simd::Int, N_OFFSETS>, N>& locations) const
+		{
+			using Int = typename Simd::Int;
+			constexpr size_t N_PREFIXES = Power(N_OFFSETS, N - 1);
+
+			// The combinations share the first steps of "GetRandomIndex", e.g., the first step only
+			// depends on the location along the first dimension. Every step is therefore only
+			// performed once per distinct prefix, instead of once per combination.
+			std::array<Int, N_PREFIXES> indices;
+			indices[0] = Simd::SetInt(0);
+			size_t nPrefixes = 1;
+			for (int i = 0; i < N - 1; ++i)
+			{
+				// Goes backwards, so that the shorter prefixes are read before they get overwritten
+				for (size_t prefix = nPrefixes * N_OFFSETS; prefix-- > 0;)
+				{
+					indices[prefix] = Simd::Gather(mBatchPermutationTable.data(),
+						Simd::AddInt(locations[i][prefix / nPrefixes], indices[prefix % nPrefixes]));
+				}
+				nPrefixes *= N_OFFSETS;
+			}
+
+			std::array<Int, Power(N_OFFSETS, N)> batchHashes;
+			noise::ForEachIndex<Power(N_OFFSETS, N)>([&](auto combination)
+				{
+					batchHashes[combination] = Simd::AddInt(locations[N - 1][combination / N_PREFIXES], indices[combination % N_PREFIXES]);
+				});
+			return batchHashes;
+		}
+		size_t GetRandomIndexOfBatchHash(const size_t batchHash) const
+		{
+			return (*mPermutationTable)[batchHash];
+		}
+	private:
+		// Store the permutation table as a shared pointer so that we do not have to
+		// allocate a permutation table for every instance of the noise. Instances of
+		// PerlinNoise<2> and PerlinNoise<3> can now for example share the same
+		// permutation table.
+		std::shared_ptr<const PermutationTable<N_RANDOM_VALUES>> mPermutationTable;
+		// A copy of the permutation table, which is laid out for the gather instructions
+		std::array<int, BATCH_HASH_COUNT> mBatchPermutationTable;
+	};
+
+	// Mixes the elements of the location with a few integer multiplications and shifts. Needs no
+	// memory at all, so the corners get hashed independently of each other and of the caches.
+	// Supports up to four dimensions.
+	template<int N_RANDOM_VALUES>
+	class IntegerHash
+	{
+	public:
+		static constexpr size_t BATCH_HASH_COUNT = N_RANDOM_VALUES;
+
+		explicit IntegerHash(const uint64_t seed = noise::DEFAULT_SEED)
+			:
+			mSeed((uint32_t)SplitMix64(seed).Next())
+		{}
+
+		template<int N>
+		requires(N <= 4)
+		size_t GetRandomIndex(const std::array<int, N>& location) const
+		{
+			uint32_t hash = mSeed;
+			for (int i = 0; i < N; ++i)
+			{
+				hash ^= (uint32_t)location[i] * MULTIPLIERS[i];
+			}
+			return noise::MixBits(hash) & (N_RANDOM_VALUES - 1);
+		}
+		template<class Simd, int N, size_t N_OFFSETS = 2>
+		requires(N <= 4)
+		std::array<typename Simd::Int, Power(N_OFFSETS, N)> GetBatchHashes(const std::array<std::array<typename Simd::Int, N_OFFSETS>, N>& locations) const
+		{
+			using Int = typename Simd::Int;
+
+			// Every location only gets multiplied once, instead of once per combination
+			std::array<std::array<Int, N_OFFSETS>, N> products;
+			for (int i = 0; i < N; ++i)
+			{
+				for (size_t offset = 0; offset < N_OFFSETS; ++offset)
+				{
+					products[i][offset] = Simd::MulInt(locations[i][offset], Simd::SetInt((int)MULTIPLIERS[i]));
+				}
+			}
+
+			std::array<Int, Power(N_OFFSETS, N)> batchHashes;
+			noise::ForEachIndex<Power(N_OFFSETS, N)>([&](auto combination)
+				{
+					Int hash = Simd::SetInt((int)mSeed);
+					size_t remainingCombination = combination;
+					for (int i = 0; i < N; ++i)
+					{
+						hash = Simd::XorInt(hash, products[i][remainingCombination % N_OFFSETS]);
+						remainingCombination /= N_OFFSETS;
+					}
+					batchHashes[combination] = Simd::AndInt(MixBits<Simd>(hash), Simd::SetInt(N_RANDOM_VALUES - 1));
+				});
+			return batchHashes;
+		}
+		size_t GetRandomIndexOfBatchHash(const size_t batchHash) const
+		{
+			return batchHash;
+		}
+		// The 32-bit seed that the hash starts from, e.g., for the shaders
+		uint32_t GetSeed() const
+		{
+			return mSeed;
+		}
+	private:
+		// The same as "noise::MixBits", for "Simd::WIDTH" values at once
+		template<class Simd>
+		static typename Simd::Int MixBits(typename Simd::Int hash)
+		{
+			hash = Simd::XorInt(hash, Simd::ShiftRightLogicalInt(hash, 16));
+			hash = Simd::MulInt(hash, Simd::SetInt((int)0x7FEB352D));
+			hash = Simd::XorInt(hash, Simd::ShiftRightLogicalInt(hash, 15));
+			hash = Simd::MulInt(hash, Simd::SetInt((int)0x846CA68B));
+			hash = Simd::XorInt(hash, Simd::ShiftRightLogicalInt(hash, 16));
+			return hash;
+		}
+	private:
+		// Large odd constants, one per dimension
+		static constexpr std::array<uint32_t, 4> MULTIPLIERS = { 0x8DA6B343, 0xD8163841, 0xCB1AB31F, 0x9E3779B1 };
+
+		uint32_t mSeed;
+	};
+}
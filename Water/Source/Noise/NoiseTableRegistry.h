@@ -0,0 +1,40 @@
+#pragma once
+#include <mutex>
+#include "PermutationTable.h"
+#include "RandomValueTable.h"
+
+// Hands out one table per type, size and seed, so that everything that asks for the same seed,
+// e.g., the CPU noise and the permutation texture of the shaders, shares the very same table.
+// The tables are kept alive until the program exits.
+class NoiseTableRegistry
+{
+public:
+	// Thread-safe
+	template<int N>
+	static std::shared_ptr<const PermutationTable<N>> GetPermutationTable(const uint64_t seed = noise::DEFAULT_SEED)
+	{
+		return GetTable<PermutationTable<N>>(seed);
+	}
+	// Thread-safe
+	template<int N>
+	static std::shared_ptr<const RandomValueTable<N>> GetRandomValueTable(const uint64_t seed = noise::DEFAULT_SEED)
+	{
+		return GetTable<RandomValueTable<N>>(seed);
+	}
+private:
+	// Every type of table gets its own map
+	template<class TableT>
+	static std::shared_ptr<const TableT> GetTable(const uint64_t seed)
+	{
+		static std::mutex mutex;
+		static std::unordered_map<uint64_t, std::shared_ptr<const TableT>> tables;
+
+		std::lock_guard lockGuard(mutex);
+		std::shared_ptr<const TableT>& table = tables[seed];
+		if (!table)
+		{
+			table = std::make_shared<const TableT>(seed);
+		}
+		return table;
+	}
+};
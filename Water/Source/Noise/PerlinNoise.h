@@ -2,207 +2,326 @@
 
 #include "../Mathematics/Vector/Vector.h"
 #include "../Mathematics/Algorithms.h"
-#include "PermutationTable.h"
+#include "NoiseHash.h"
+#include "NoiseCorners.h"
+#include "NoiseBatch.h"
+#include "NoiseGradient.h"
 #include "../CustomConcepts.h"
+#include <array>
+
+namespace noise
+{
+	// The vectors that point from the center of a cube with "VECTOR_SIZE" dimensions to the centers of its edges
+	template<int VECTOR_SIZE>
+	constexpr auto CreateDiagonalVectors()
+	{
+		// For every element, there are 2 ^ (VECTOR_SIZE - 1) combinations of the other elements
+		constexpr size_t N_COMBINATIONS = (size_t)1 << (VECTOR_SIZE - 1);
+		std::array<std::array<float, VECTOR_SIZE>, VECTOR_SIZE * N_COMBINATIONS> diagonalVectors = {};
+
+		for (int i = 0; i < VECTOR_SIZE; ++i)
+		{
+			// Only one element of the diagonal vector is going to be 0, the i-th element.
+			// The rest of the elements are going to be either -1 or 1.
+			for (size_t combination = 0; combination < N_COMBINATIONS; ++combination)
+			{
+				std::array<float, VECTOR_SIZE>& diagonalVector = diagonalVectors[i * N_COMBINATIONS + combination];
+				for (int j = 0; j < VECTOR_SIZE; ++j)
+				{
+					if (j == i)
+					{
+						// The i-th element is always going to be 0
+						diagonalVector[j] = 0.0f;
+					}
+					else
+					{
+						// We let the j-th bit of "combination" decide whether the j:th element should
+						// contain -1 or 1. However, since we skip one bit when j = i, we need to subtract
+						// 1 from j when j > i.
+						const int bit = j > i ? j - 1 : j;
+						diagonalVector[j] = ((combination >> bit) & 1) ? -1.0f : 1.0f;
+					}
+				}
+			}
+		}
+		return diagonalVectors;
+	}
+}
 
 // "VECTOR_SIZE" is the dimension of the diagonal pointing vectors. In order to not
 // make the amount of diagonal vectors too few, we make sure that the value is at least 3.
-template<int N, int N_RANDOM_VALUES = 256, int VECTOR_SIZE = std::max(3, N)>
+// "HashT" hashes the corners of the lattice, e.g., "noise::PermutationHash" or "noise::IntegerHash".
+template<int N, int N_RANDOM_VALUES = 256, int VECTOR_SIZE = std::max(3, N), class HashT = noise::PermutationHash<N_RANDOM_VALUES>>
 // N_RANDOM_VALUES needs to be a power of two, since we need to use the &-operator instead
 // of the %-operator
 requires(IsPowerOfTwo(N_RANDOM_VALUES))
 class PerlinNoise
 {
 public:
-	PerlinNoise(const std::shared_ptr<PermutationTable<N_RANDOM_VALUES>> permutationTable)
+	// A shared pointer to a permutation table converts to the default "HashT"
+	PerlinNoise(const HashT& hash)
 		:
-		mPermutationTable(permutationTable)
+		mHash(hash)
 	{
-		InitializeCornerOffets();
-		InitializeDiagonalVectors();
+		InitializeBatchTables();
 	}
 
 	float Get(const BasicVector<float, N>& position) const
 	{
-		// The floored integer position of the input vector 
-		BasicVector<int, N> location;
-		std::transform(position.begin(), position.end(), location.begin(),
-			[](float value)
-			{
-				return (int)std::floor(value);
-			});
-		
+		// The floored integer position of the input vector
+		std::array<int, N> location;
 		// A vector pointing from location to the input position
-		BasicVector<float, N> toPosition;
-		std::transform(position.begin(), position.end(), location.begin(), toPosition.begin(),
-			[](float value, int flooredValue)
-			{
-				return value - (float)flooredValue;
-			});
-		
+		std::array<float, N> toPosition;
 		// The same as "toPosition", except that we smoothstep all of the elements, in order
 		// to make the interpolation between the random values smoother
-		BasicVector<float, N> interpolationAmounts;
-		std::transform(toPosition.begin(), toPosition.end(), interpolationAmounts.begin(),
-			[this](float value)
-			{
-				return Smoothstep(value);
-			});
-
-		// Contains the random corner values
-		float cornerValues[N_CORNERS];
-		for (int i = 0; i < N_CORNERS; ++i)
+		std::array<float, N> interpolationAmounts;
+		for (int i = 0; i < N; ++i)
 		{
-			// The location of the i-th corner
-			BasicVector<int, N> cornerLocation = mCornerOffsets[i] + location;
-			// We need to apply the modulo-operator, in order to not exceed the size
-			// of the permutation table
-			ApplyModulo(cornerLocation);
-
-			BasicVector<float, N> cornerToPosition = toPosition - BasicVector<float, N>(mCornerOffsets[i]);
-			// The random vectors have a size of "VECTOR_SIZE" and we need "cornerToPosition" to have the 
-			// same size, in order for us to be able to perform the dot product
-			BasicVector<float, VECTOR_SIZE> cornerToPositionSizeCorrected;
-			std::copy(cornerToPosition.begin(), cornerToPosition.end(), cornerToPositionSizeCorrected.begin());
-
-			cornerValues[i] = GetPerlinValue(GetRandomIndex(cornerLocation), cornerToPositionSizeCorrected);
+			const float flooredValue = std::floor(position[i]);
+			location[i] = (int)flooredValue;
+			toPosition[i] = position[i] - flooredValue;
+			interpolationAmounts[i] = Smoothstep(toPosition[i]);
 		}
 
+		// Contains the random corner values
+		std::array<float, N_CORNERS> cornerValues;
+		noise::ForEachCorner<N>([&](auto corner)
+			{
+				constexpr std::array<int, N> cornerOffset = CORNER_OFFSETS[corner];
+
+				// The location of the corner. We need to apply the modulo-operator, in
+				// order to not exceed the size of the permutation table.
+				std::array<int, N> cornerLocation;
+				for (int i = 0; i < N; ++i)
+				{
+					cornerLocation[i] = ApplyModulo(location[i] + cornerOffset[i]);
+				}
+
+				cornerValues[corner] = GetPerlinValue(mHash.template GetRandomIndex<N>(cornerLocation), toPosition, cornerOffset);
+			});
+
 		// Interpolate between the "cornerValues" based on the "interpolationAmounts".
 		// Interpolate returns a value between -1 and 1. We make the value range between 0
 		// and 1 by first adding 1 to the value and then dividing the result by 2.
-		return (Interpolate(cornerValues, interpolationAmounts) + 1.0f) / 2.0f;
+		const float value = noise::InterpolateCorners(cornerValues, interpolationAmounts,
+			[](float a, float b, float amount)
+			{
+				return Lerp(a, b, amount);
+			});
+		return (value + 1.0f) / 2.0f;
 	}
-private:
-	float GetPerlinValue(const size_t index, const BasicVector<float, VECTOR_SIZE>& cornerToPosition) const
+	// The same value as "Get", together with its partial derivatives. Evaluates the corners once, instead
+	// of the N + 1 times that finite differences would need. The noise repeats every "period" units along
+	// every dimension, which needs to be a power of two that does not exceed "N_RANDOM_VALUES". A smaller
+	// period makes the noise tileable over a smaller area, e.g., for "noise::BakeTileable".
+	noise::ValueWithGradient<N> GetWithGradient(const BasicVector<float, N>& position, int period = N_RANDOM_VALUES) const
 	{
-		// Make the index not exceed the size of the container by applying the %-operator
-		return mDiagonalVectors[index % mDiagonalVectors.size()].Dot(cornerToPosition);
+		assert(IsPowerOfTwo(period) && period <= N_RANDOM_VALUES);
+
+		std::array<int, N> location;
+		std::array<float, N> toPosition;
+		std::array<InterpolationAmount, N> interpolationAmounts;
+		for (int i = 0; i < N; ++i)
+		{
+			const float flooredValue = std::floor(position[i]);
+			location[i] = (int)flooredValue;
+			toPosition[i] = position[i] - flooredValue;
+			interpolationAmounts[i] = { Smoothstep(toPosition[i]), SmoothstepDerivative(toPosition[i]), i };
+		}
+
+		std::array<CornerSample, N_CORNERS> cornerSamples;
+		noise::ForEachCorner<N>([&](auto corner)
+			{
+				constexpr std::array<int, N> cornerOffset = CORNER_OFFSETS[corner];
+
+				std::array<int, N> cornerLocation;
+				for (int i = 0; i < N; ++i)
+				{
+					cornerLocation[i] = (location[i] + cornerOffset[i]) & (period - 1);
+				}
+
+				const size_t index = mHash.template GetRandomIndex<N>(cornerLocation);
+				const std::array<float, VECTOR_SIZE>& diagonalVector = DIAGONAL_VECTORS[index % DIAGONAL_VECTORS.size()];
+
+				// The corner value is a dot product with the diagonal vector, so the diagonal vector is its gradient
+				cornerSamples[corner].value = GetPerlinValue(index, toPosition, cornerOffset);
+				std::copy_n(diagonalVector.begin(), N, cornerSamples[corner].gradient.begin());
+			});
+
+		const CornerSample sample = noise::InterpolateCorners(cornerSamples, interpolationAmounts,
+			[](const CornerSample& a, const CornerSample& b, const InterpolationAmount& amount)
+			{
+				CornerSample result;
+				result.value = Lerp(a.value, b.value, amount.value);
+				for (int i = 0; i < N; ++i)
+				{
+					result.gradient[i] = Lerp(a.gradient[i], b.gradient[i], amount.value);
+				}
+				// The interpolation amount also changes along its own dimension
+				result.gradient[amount.dimension] += (b.value - a.value) * amount.derivative;
+				return result;
+			});
+
+		// Same mapping from [-1, 1] to [0, 1] as "Get", which also halves the gradient
+		noise::ValueWithGradient<N> valueWithGradient;
+		valueWithGradient.value = (sample.value + 1.0f) / 2.0f;
+		for (int i = 0; i < N; ++i)
+		{
+			valueWithGradient.gradient[i] = sample.gradient[i] / 2.0f;
+		}
+		return valueWithGradient;
+	}
+	// Evaluates "Get" for a batch of positions, using the widest instruction set that the CPU supports
+	void GetMany(const noise::Positions<N>& positions, std::span<float> out) const
+	{
+		noise::EvaluateMany<N>(*this, positions, out);
+	}
+	void GetMany(std::span<const float> xs, std::span<const float> ys, std::span<float> out) const
+	requires(N == 2)
+	{
+		GetMany({ xs, ys }, out);
 	}
-	float Interpolate(float* cornerValues, const BasicVector<float, N>& interpolationAmounts) const
+	void GetMany(std::span<const float> xs, std::span<const float> ys, std::span<const float> zs, std::span<float> out) const
+	requires(N == 3)
 	{
-		auto end = cornerValues + N_CORNERS;
-		for(auto interpolationAmount : interpolationAmounts)
+		GetMany({ xs, ys, zs }, out);
+	}
+	// Evaluates "Simd::WIDTH" positions at once, which lets layers like "FbmNoise" keep the positions in registers.
+	// Gives the same result as "Get", apart from the rounding of the fused multiply-adds.
+	template<class Simd>
+	typename Simd::Float Evaluate(const std::array<typename Simd::Float, N>& position) const
+	{
+		using Float = typename Simd::Float;
+		using Int = typename Simd::Int;
+
+		const Int mask = Simd::SetInt(N_RANDOM_VALUES - 1);
+
+		// The wrapped locations and the vectors to the position, for a corner offset of 0 and 1 respectively
+		std::array<std::array<Int, 2>, N> locations;
+		std::array<std::array<Float, 2>, N> toPositions;
+		std::array<Float, N> interpolationAmounts;
+		for (int i = 0; i < N; ++i)
 		{
-			auto currentDestination = cornerValues;
-			for (auto iterator = cornerValues; iterator != end; std::advance(iterator, 2), ++currentDestination)
-			{
-				// Interpolate between the adjacent corner values
-				*currentDestination = Lerp(*iterator, *(iterator + 1), interpolationAmount);
-			}
-			// Set the end to be the iterator pointing to the result of the last interpolation + 1,
-			// effectively cutting the amount of corner values in half after each "interpolationAmount"-loop
-			end = currentDestination;
+			const Float floored = Simd::Floor(position[i]);
+			const Int location = Simd::ToInt(floored);
+
+			locations[i] = { Simd::AndInt(location, mask), Simd::AndInt(Simd::AddInt(location, Simd::SetInt(1)), mask) };
+			toPositions[i][0] = Simd::Sub(position[i], floored);
+			toPositions[i][1] = Simd::Sub(toPositions[i][0], Simd::Set(1.0f));
+			interpolationAmounts[i] = Smoothstep<Simd>(toPositions[i][0]);
 		}
 
-		return cornerValues[0];
+		const std::array<Int, N_CORNERS> batchHashes = mHash.template GetBatchHashes<Simd, N>(locations);
+
+		std::array<Float, N_CORNERS> cornerValues;
+		noise::ForEachCorner<N>([&](auto corner)
+			{
+				constexpr std::array<int, N> cornerOffset = CORNER_OFFSETS[corner];
+
+				// The last step of the hash is merged with the lookup of the diagonal vector
+				const Int diagonalVector = Simd::Gather(mBatchDiagonalVectors.data(), batchHashes[corner]);
+
+				Float dot = Simd::Mul(UnpackDiagonalElement<Simd>(diagonalVector, 0), toPositions[0][cornerOffset[0]]);
+				for (int i = 1; i < N; ++i)
+				{
+					dot = Simd::MulAdd(UnpackDiagonalElement<Simd>(diagonalVector, i), toPositions[i][cornerOffset[i]], dot);
+				}
+				cornerValues[corner] = dot;
+			});
+
+		const Float value = noise::InterpolateCorners(cornerValues, interpolationAmounts,
+			[](Float a, Float b, Float amount)
+			{
+				return Simd::MulAdd(Simd::Sub(b, a), amount, a);
+			});
+		return Simd::MulAdd(value, Simd::Set(0.5f), Simd::Set(0.5f));
+	}
+
+	static constexpr int DIMENSION = N;
+private:
+	struct CornerSample
+	{
+		float value;
+		std::array<float, N> gradient;
+	};
+	struct InterpolationAmount
+	{
+		float value;
+		// The derivative of "value" along the "dimension"-th dimension
+		float derivative;
+		int dimension;
+	};
+
+	// Unpacks the "elementIndex"-th element of a diagonal vector packed by "InitializeBatchTables"
+	template<class Simd>
+	static typename Simd::Float UnpackDiagonalElement(typename Simd::Int packedDiagonalVector, int elementIndex)
+	{
+		const typename Simd::Int bits = Simd::AndInt(Simd::ShiftRightInt(packedDiagonalVector, 2 * elementIndex), Simd::SetInt(0b11));
+		return Simd::ToFloat(Simd::SubInt(bits, Simd::SetInt(1)));
+	}
+	template<class Simd>
+	static typename Simd::Float Smoothstep(typename Simd::Float t)
+	{
+		// t * t * t * (10.0f + t * (6.0f * t - 15.0f))
+		const typename Simd::Float polynomial = Simd::MulAdd(t, Simd::MulAdd(t, Simd::Set(6.0f), Simd::Set(-15.0f)), Simd::Set(10.0f));
+		return Simd::Mul(Simd::Mul(Simd::Mul(t, t), t), polynomial);
 	}
-	size_t GetRandomIndex(const BasicVector<int, N>& location) const
+	float GetPerlinValue(const size_t index, const std::array<float, N>& toPosition, const std::array<int, N>& cornerOffset) const
 	{
-		size_t index = 0;
-		// Combine all of the location's elements into one index, effectively
-		// hashing the location
+		// Make the index not exceed the size of the container by applying the %-operator
+		const std::array<float, VECTOR_SIZE>& diagonalVector = DIAGONAL_VECTORS[index % DIAGONAL_VECTORS.size()];
+
+		// The dot product between the diagonal vector and the vector pointing from the corner to the position.
+		// The elements of the latter vector that exceed N are 0, so they do not contribute to the dot product.
+		float dot = 0.0f;
 		for (int i = 0; i < N; ++i)
 		{
-			index = (*mPermutationTable)[location[i] + index];
+			dot += diagonalVector[i] * (toPosition[i] - (float)cornerOffset[i]);
 		}
-	
-		return index;
+		return dot;
 	}
-	float Smoothstep(float t) const
+	static float Smoothstep(float t)
 	{
 		return t * t * t * (10.0f + t * (6.0f * t - 15.0f));
 	}
-	void ApplyModulo(BasicVector<int, N>& location) const
+	static float SmoothstepDerivative(float t)
+	{
+		return 30.0f * t * t * (t * (t - 2.0f) + 1.0f);
+	}
+	static int ApplyModulo(int value)
 	{
-		// We apply the &-operator to the location, which is the same (as long as 
-		// we subtract 1 from the value, e.g., "N_RANDOM_VALUES - 1") as 
+		// We apply the &-operator to the value, which is the same (as long as
+		// we subtract 1 from the value, e.g., "N_RANDOM_VALUES - 1") as
 		// applying the %-operator for positive values since "N_RANDOM_VALUES" is a
 		// power of 2
-		std::for_each(location.begin(), location.end(),
-			[](int& value)
-			{
-				value = int(value & (N_RANDOM_VALUES - 1));
-			});
+		return value & (N_RANDOM_VALUES - 1);
 	}
-	void InitializeCornerOffets()
+	void InitializeBatchTables()
 	{
-		int moduloValues[N];
-		for (int i = 0; i < N; ++i)
+		// Looking up the diagonal vector directly by the batch hash saves a dependent load per corner.
+		// Only the first N elements are needed, since the remaining elements of "cornerToPosition" are always 0.
+		for (size_t i = 0; i < mBatchDiagonalVectors.size(); ++i)
 		{
-			// The moduloValue decides how often the corresponding element
-			// inside the diagonal vectors changes from 0 to 1. 
-			// For i = 0, we get a modulo value of 2 ^ (0 + 1) = 2,
-			// which means that the first (0) element is going to be 0 for 2 / 2 = 1 diagonalVectors
-			// in a row. For i = 2, we get a modulo value of 2 ^ (2 + 1) = 8,
-			// which means that the third (2) element is going to be 0 for 8 / 2 = 4 diagonalVectors
-			// in a row, etc.
-			moduloValues[i] = (int)std::pow(2.0, (double)i + 1);
-		}
+			const size_t index = mHash.GetRandomIndexOfBatchHash(i);
+			const std::array<float, VECTOR_SIZE>& diagonalVector = DIAGONAL_VECTORS[index % DIAGONAL_VECTORS.size()];
 
-		for (int i = 0; i < N_CORNERS; ++i)
-		{
-			BasicVector<int, N> cornerOffset;
+			// The elements are either -1, 0 or 1, so every element fits into two bits as "element + 1".
+			// One gather then fetches the whole vector, instead of one gather per element.
+			int packedDiagonalVector = 0;
 			for (int j = 0; j < N; ++j)
 			{
-				int moduloValue = moduloValues[j];
-				// We can use a &-operator instead of the %-operator since moduloValue is
-				// by definition a power of 2 (note that we then need to subtract 1 from
-				// the modulo value: "moduloValue - 1"
-				cornerOffset[j] = ((i & (moduloValue - 1)) < moduloValue / 2) ? 0 : 1;
-			}
-			mCornerOffsets.push_back(cornerOffset);
-		}
-	}
-	void InitializeDiagonalVectors()
-	{
-		BasicVector<float, VECTOR_SIZE> diagonalVector;
-		for (int i = 0; i < VECTOR_SIZE; ++i)
-		{
-			// Only one element of the diagonal vector is going to be 0, the i-th element. 
-			// The rest of the elements are going to be either -1 or 1. The amount of
-			// combinations for this iterations is therefore going to be the 2 ^ (amount of elements - 1)
-			for (unsigned char combination = 0; combination < (int)std::pow(2.0, VECTOR_SIZE - 1); ++combination)
-			{
-				// Initialize all of the elements of the current diagonal vector
-				for (int j = 0; j < VECTOR_SIZE; ++j)
-				{
-					if (j == i)
-					{
-						// The i-th element is always going to be 0
-						diagonalVector[j] = 0.0f;
-					}
-					else
-					{
-						// We let the j-th bit of "combination" decide whether the j:th element should
-						// contain -1 or 1. However, since we skip one bit when j = i, we need to subtract
-						// 1 from j when j > i.
-						int bit = j > i ? j - 1 : j;
-						diagonalVector[j] = GetBit(combination, bit) ? -1.0f : 1.0f;
-					}
-				}
-				mDiagonalVectors.push_back(diagonalVector);
+				packedDiagonalVector |= ((int)diagonalVector[j] + 1) << (2 * j);
 			}
+			mBatchDiagonalVectors[i] = packedDiagonalVector;
 		}
 	}
-	bool GetBit(unsigned char number, int bitIndex) const
-	{
-		// Make sure that the "bitIndex" does not exceed the 
-		// size of the number
-		assert(bitIndex < 8);
-
-		// Test if the bit at "bitIndex" is set
-		return bool(number & (unsigned char)(0b1 << bitIndex));
-	}
 private:
 	static constexpr size_t N_CORNERS = Power(2, N);
+	static constexpr noise::CornerOffsets<N> CORNER_OFFSETS = noise::CreateCornerOffsets<N>();
+	static constexpr auto DIAGONAL_VECTORS = noise::CreateDiagonalVectors<VECTOR_SIZE>();
 
-	// Store the permutation table as a shared pointer so that we do not have to
-	// allocate a permutation table for every instance of this class. Instances of
-	// PerlinNoise<2> and PerlinNoise<3> can now for example share the same
-	// permutation table.
-	std::shared_ptr<PermutationTable<N_RANDOM_VALUES>> mPermutationTable;
+	HashT mHash;
 
-	std::vector<BasicVector<int, N>> mCornerOffsets;
-	std::vector<BasicVector<float, VECTOR_SIZE>> mDiagonalVectors;
-};
\ No newline at end of file
+	// The diagonal vector of every batch hash, packed into an int and laid out for "GetMany"
+	std::array<int, HashT::BATCH_HASH_COUNT> mBatchDiagonalVectors;
+};
@@ -1,41 +1,62 @@
 #pragma once
-#include <random>
+#include <limits>
+#include "SplitMix64.h"
 
+// A shuffle of the values 0 to N - 1, determined by the seed. The constructor is constexpr,
+// so a table can also be generated at compile time, e.g., "constexpr PermutationTable<256> table(seed)".
 template<class T, int N>
 class BasicPermutationTable
 {
 public:
-	BasicPermutationTable()
+	static_assert(N - 1 <= std::numeric_limits<T>::max(), "T is too small to hold the indices");
+
+	constexpr explicit BasicPermutationTable(const uint64_t seed = noise::DEFAULT_SEED)
+		:
+		mSeed(seed)
 	{
-		std::random_device randomNumberGenerator;
-		std::mt19937 randomNumberEngine(randomNumberGenerator());
-		std::uniform_int_distribution distributor(0, N - 1);
+		for (int i = 0; i < N; ++i)
+		{
+			mPermutationTable[i] = (T)i;
+		}
+
+		// Fisher-Yates shuffle
+		noise::SplitMix64 randomNumberGenerator(seed);
+		for (int i = N - 1; i > 0; --i)
+		{
+			const size_t j = (size_t)randomNumberGenerator.NextBelow((uint64_t)i + 1);
+			std::swap(mPermutationTable[i], mPermutationTable[j]);
+		}
 
-		std::generate(std::begin(mPermutationTable), std::end(mPermutationTable),
-			[&]()
-			{
-				return (T)distributor(randomNumberEngine);
-			});
+		// The second half repeats the first one, so that index and index + N map to the same value
+		for (int i = N; i < N * 2 - 1; ++i)
+		{
+			mPermutationTable[i] = mPermutationTable[i - N];
+		}
 	}
-	T operator[](const size_t index) const
+	constexpr T operator[](const size_t index) const
 	{
 		assert(index >= 0 && index < Size());
 		return mPermutationTable[index];
 	}
-	T* GetPointerToData()
+	constexpr const T* GetPointerToData() const
 	{
 		return mPermutationTable;
 	}
-	size_t Size() const
+	constexpr size_t Size() const
 	{
 		return N * 2 - 1;
 	}
+	constexpr uint64_t GetSeed() const
+	{
+		return mSeed;
+	}
 private:
-	// Contains random indices that ranges from 0 to N - 1. The input into the 
-	// table is the sum of two values that both range between 0 to N - 1 and therefore 
-	// has a maximum value of N - 1 + N - 1 = N * 2 - 2. 
+	uint64_t mSeed;
+	// Contains random indices that ranges from 0 to N - 1. The input into the
+	// table is the sum of two values that both range between 0 to N - 1 and therefore
+	// has a maximum value of N - 1 + N - 1 = N * 2 - 2.
 	// The table therefore needs a size of N * 2 - 1 (including the value 0).
-	T mPermutationTable[N * 2 - 1];
+	T mPermutationTable[N * 2 - 1] = {};
 };
 
 template<int N>
@@ -1,24 +1,32 @@
 #pragma once
-#include <random>
+#include "SplitMix64.h"
 
+// N random values between 0 and 1, determined by the seed. The constructor is constexpr,
+// so a table can also be generated at compile time.
 template<int N>
 class RandomValueTable
 {
 public:
-	RandomValueTable()
+	constexpr explicit RandomValueTable(const uint64_t seed = noise::DEFAULT_SEED)
+		:
+		mSeed(seed)
 	{
-		std::random_device randomNumberGenerator;
-		std::mt19937 randomNumberEngine(randomNumberGenerator());
-		std::uniform_real_distribution distributor(0.0f, 1.0f);
-
-		std::generate(std::begin(mRandomValues), std::end(mRandomValues),
-			std::bind(distributor, std::ref(randomNumberEngine)));
+		noise::SplitMix64 randomNumberGenerator(seed);
+		for (float& randomValue : mRandomValues)
+		{
+			randomValue = randomNumberGenerator.NextFloat();
+		}
 	}
-	float operator[](const size_t index) const
+	constexpr float operator[](const size_t index) const
 	{
 		assert(index >= 0 && index < N);
 		return mRandomValues[index];
 	}
+	constexpr uint64_t GetSeed() const
+	{
+		return mSeed;
+	}
 private:
-	float mRandomValues[N];
+	uint64_t mSeed;
+	float mRandomValues[N] = {};
 };
\ No newline at end of file
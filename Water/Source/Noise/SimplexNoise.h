@@ -0,0 +1,295 @@
+#pragma once
+
+#include "../Mathematics/Vector/Vector.h"
+#include "../Mathematics/Algorithms.h"
+#include "NoiseHash.h"
+#include "PerlinNoise.h"
+#include "NoiseBatch.h"
+#include "NoiseGradient.h"
+#include "../CustomConcepts.h"
+#include <array>
+
+// Gradient noise that, instead of interpolating between the 2 ^ N corners of a hypercube, sums the
+// contributions of the N + 1 corners of the simplex that surrounds the position. 3D noise therefore only
+// evaluates 4 corners instead of 8, and 4D noise 5 instead of 16. Uses the same hash policies and
+// diagonal vectors as "PerlinNoise", so the two can share a permutation table.
+template<int N, int N_RANDOM_VALUES = 256, int VECTOR_SIZE = std::max(3, N), class HashT = noise::PermutationHash<N_RANDOM_VALUES>>
+// N_RANDOM_VALUES needs to be a power of two, since we need to use the &-operator instead
+// of the %-operator. The scale that normalizes the value is only known for 2 to 4 dimensions.
+requires(IsPowerOfTwo(N_RANDOM_VALUES) && N >= 2 && N <= 4)
+class SimplexNoise
+{
+public:
+	// A shared pointer to a permutation table converts to the default "HashT"
+	SimplexNoise(const HashT& hash)
+		:
+		mHash(hash)
+	{
+		InitializeBatchTables();
+	}
+
+	float Get(const BasicVector<float, N>& position) const
+	{
+		std::array<float, N> unusedGradient;
+		// Make the value range between 0 and 1
+		return Sum<false>(position, unusedGradient) * SCALE * 0.5f + 0.5f;
+	}
+	// The same value as "Get", together with its partial derivatives
+	noise::ValueWithGradient<N> GetWithGradient(const BasicVector<float, N>& position) const
+	{
+		std::array<float, N> gradient;
+		noise::ValueWithGradient<N> valueWithGradient;
+		valueWithGradient.value = Sum<true>(position, gradient) * SCALE * 0.5f + 0.5f;
+		for (int i = 0; i < N; ++i)
+		{
+			valueWithGradient.gradient[i] = gradient[i] * SCALE * 0.5f;
+		}
+		return valueWithGradient;
+	}
+	// Evaluates "Get" for a batch of positions, using the widest instruction set that the CPU supports
+	void GetMany(const noise::Positions<N>& positions, std::span<float> out) const
+	{
+		noise::EvaluateMany<N>(*this, positions, out);
+	}
+	void GetMany(std::span<const float> xs, std::span<const float> ys, std::span<float> out) const
+	requires(N == 2)
+	{
+		GetMany({ xs, ys }, out);
+	}
+	void GetMany(std::span<const float> xs, std::span<const float> ys, std::span<const float> zs, std::span<float> out) const
+	requires(N == 3)
+	{
+		GetMany({ xs, ys, zs }, out);
+	}
+	// Evaluates "Simd::WIDTH" positions at once. Gives the same result as "Get", apart from
+	// the rounding of the fused multiply-adds.
+	template<class Simd>
+	typename Simd::Float Evaluate(const std::array<typename Simd::Float, N>& position) const
+	{
+		using Float = typename Simd::Float;
+		using Int = typename Simd::Int;
+
+		Float skew = position[0];
+		for (int i = 1; i < N; ++i)
+		{
+			skew = Simd::Add(skew, position[i]);
+		}
+		skew = Simd::Mul(skew, Simd::Set(SKEW_FACTOR));
+
+		std::array<Int, N> locations;
+		std::array<Float, N> toPositions;
+		Float unskew = Simd::Set(0.0f);
+		for (int i = 0; i < N; ++i)
+		{
+			toPositions[i] = Simd::Floor(Simd::Add(position[i], skew));
+			locations[i] = Simd::ToInt(toPositions[i]);
+			unskew = Simd::Add(unskew, toPositions[i]);
+		}
+		unskew = Simd::Mul(unskew, Simd::Set(UNSKEW_FACTOR));
+		for (int i = 0; i < N; ++i)
+		{
+			toPositions[i] = Simd::Sub(position[i], Simd::Sub(toPositions[i], unskew));
+		}
+
+		// The comparison masks are -1 where they hold, so subtracting a mask counts the lanes where it holds
+		std::array<Int, N> ranks;
+		ranks.fill(Simd::SetInt(0));
+		for (int i = 0; i < N; ++i)
+		{
+			for (int j = i + 1; j < N; ++j)
+			{
+				const Int isLess = Simd::LessThan(toPositions[i], toPositions[j]);
+				ranks[i] = Simd::SubInt(ranks[i], isLess);
+				ranks[j] = Simd::AddInt(ranks[j], Simd::AddInt(isLess, Simd::SetInt(1)));
+			}
+		}
+
+		// The corners are unrolled, since the offsets of the first and the last corner are known at compile time
+		Float value = Simd::Set(0.0f);
+		[&]<int... CORNERS>(std::integer_sequence<int, CORNERS...>)
+		{
+			((value = Simd::Add(value, EvaluateCorner<Simd, CORNERS>(locations, toPositions, ranks))), ...);
+		}(std::make_integer_sequence<int, N + 1>{});
+
+		return Simd::MulAdd(value, Simd::Set(SCALE * 0.5f), Simd::Set(0.5f));
+	}
+
+	static constexpr int DIMENSION = N;
+private:
+	// The sum of the corner contributions, before it gets scaled. Also sums up the gradient of the
+	// contributions when "WITH_GRADIENT" is true.
+	template<bool WITH_GRADIENT>
+	float Sum(const BasicVector<float, N>& position, std::array<float, N>& gradient) const
+	{
+		// Skew the position, so that the simplices become the halves of hypercubes
+		float skew = 0.0f;
+		for (int i = 0; i < N; ++i)
+		{
+			skew += position[i];
+		}
+		skew *= SKEW_FACTOR;
+
+		// The floored integer position of the skewed position
+		std::array<int, N> location;
+		float unskew = 0.0f;
+		for (int i = 0; i < N; ++i)
+		{
+			location[i] = (int)std::floor(position[i] + skew);
+			unskew += (float)location[i];
+		}
+		unskew *= UNSKEW_FACTOR;
+
+		// A vector pointing from the unskewed location to the input position
+		std::array<float, N> toPosition;
+		for (int i = 0; i < N; ++i)
+		{
+			toPosition[i] = position[i] - ((float)location[i] - unskew);
+		}
+
+		// The simplex is found by stepping along the dimensions in order of decreasing "toPosition".
+		// "ranks[i]" is the amount of dimensions that are stepped along before the i-th dimension.
+		std::array<int, N> ranks = {};
+		for (int i = 0; i < N; ++i)
+		{
+			for (int j = i + 1; j < N; ++j)
+			{
+				++ranks[toPosition[i] < toPosition[j] ? i : j];
+			}
+		}
+
+		float value = 0.0f;
+		if constexpr (WITH_GRADIENT)
+		{
+			gradient.fill(0.0f);
+		}
+		for (int corner = 0; corner <= N; ++corner)
+		{
+			// The location of the corner. We need to apply the modulo-operator, in
+			// order to not exceed the size of the permutation table.
+			std::array<int, N> cornerLocation;
+			std::array<float, N> cornerToPosition;
+			for (int i = 0; i < N; ++i)
+			{
+				const int offset = ranks[i] < corner ? 1 : 0;
+				cornerLocation[i] = ApplyModulo(location[i] + offset);
+				cornerToPosition[i] = toPosition[i] - (float)offset + (float)corner * UNSKEW_FACTOR;
+			}
+
+			value += GetCornerValue<WITH_GRADIENT>(mHash.template GetRandomIndex<N>(cornerLocation), cornerToPosition, gradient);
+		}
+		return value;
+	}
+	// Unpacks the "elementIndex"-th element of a diagonal vector packed by "InitializeBatchTables"
+	template<class Simd>
+	static typename Simd::Float UnpackDiagonalElement(typename Simd::Int packedDiagonalVector, int elementIndex)
+	{
+		const typename Simd::Int bits = Simd::AndInt(Simd::ShiftRightInt(packedDiagonalVector, 2 * elementIndex), Simd::SetInt(0b11));
+		return Simd::ToFloat(Simd::SubInt(bits, Simd::SetInt(1)));
+	}
+	template<class Simd, int CORNER>
+	typename Simd::Float EvaluateCorner(const std::array<typename Simd::Int, N>& locations, const std::array<typename Simd::Float, N>& toPositions,
+		const std::array<typename Simd::Int, N>& ranks) const
+	{
+		using Float = typename Simd::Float;
+		using Int = typename Simd::Int;
+
+		// The offsets of a corner differ between the lanes, so every corner is hashed on its own
+		std::array<std::array<Int, 1>, N> cornerLocations;
+		std::array<Float, N> cornerToPositions;
+		for (int i = 0; i < N; ++i)
+		{
+			// The first corner is the location itself and the last corner is offset in every dimension
+			Int offset = Simd::SetInt(CORNER == 0 ? 0 : 1);
+			if constexpr (CORNER != 0 && CORNER != N)
+			{
+				offset = Simd::AndInt(Simd::LessThanInt(ranks[i], Simd::SetInt(CORNER)), offset);
+			}
+			cornerLocations[i][0] = Simd::AndInt(Simd::AddInt(locations[i], offset), Simd::SetInt(N_RANDOM_VALUES - 1));
+			cornerToPositions[i] = Simd::Add(Simd::Sub(toPositions[i], Simd::ToFloat(offset)), Simd::Set((float)CORNER * UNSKEW_FACTOR));
+		}
+
+		// The last step of the hash is merged with the lookup of the diagonal vector
+		const Int batchHash = mHash.template GetBatchHashes<Simd, N, 1>(cornerLocations)[0];
+		const Int diagonalVector = Simd::Gather(mBatchDiagonalVectors.data(), batchHash);
+
+		Float dot = Simd::Mul(UnpackDiagonalElement<Simd>(diagonalVector, 0), cornerToPositions[0]);
+		Float lengthSquared = Simd::Mul(cornerToPositions[0], cornerToPositions[0]);
+		for (int i = 1; i < N; ++i)
+		{
+			dot = Simd::MulAdd(UnpackDiagonalElement<Simd>(diagonalVector, i), cornerToPositions[i], dot);
+			lengthSquared = Simd::MulAdd(cornerToPositions[i], cornerToPositions[i], lengthSquared);
+		}
+
+		Float falloff = Simd::Max(Simd::Sub(Simd::Set(RADIUS_SQUARED), lengthSquared), Simd::Set(0.0f));
+		falloff = Simd::Mul(falloff, falloff);
+		return Simd::Mul(Simd::Mul(falloff, falloff), dot);
+	}
+	// Adds the gradient of the contribution to "gradient" when "WITH_GRADIENT" is true
+	template<bool WITH_GRADIENT>
+	float GetCornerValue(const size_t index, const std::array<float, N>& cornerToPosition, std::array<float, N>& gradient) const
+	{
+		// Make the index not exceed the size of the container by applying the %-operator
+		const std::array<float, VECTOR_SIZE>& diagonalVector = DIAGONAL_VECTORS[index % DIAGONAL_VECTORS.size()];
+
+		float dot = 0.0f;
+		float lengthSquared = 0.0f;
+		for (int i = 0; i < N; ++i)
+		{
+			dot += diagonalVector[i] * cornerToPosition[i];
+			lengthSquared += cornerToPosition[i] * cornerToPosition[i];
+		}
+
+		// The contribution of the corner falls off to 0 before it reaches the simplices that do not
+		// contain the corner, which keeps the noise continuous
+		const float falloff = std::max(RADIUS_SQUARED - lengthSquared, 0.0f);
+		const float falloffSquared = falloff * falloff;
+
+		if constexpr (WITH_GRADIENT)
+		{
+			// The derivative of falloff ^ 4 * dot, where the derivative of the falloff is -2 * "cornerToPosition"
+			for (int i = 0; i < N; ++i)
+			{
+				gradient[i] += falloffSquared * falloffSquared * diagonalVector[i] -
+					8.0f * falloffSquared * falloff * dot * cornerToPosition[i];
+			}
+		}
+		return falloffSquared * falloffSquared * dot;
+	}
+	static int ApplyModulo(int value)
+	{
+		return value & (N_RANDOM_VALUES - 1);
+	}
+	void InitializeBatchTables()
+	{
+		// The diagonal vectors are packed the same way as in "PerlinNoise", i.e., two bits per element
+		for (size_t i = 0; i < mBatchDiagonalVectors.size(); ++i)
+		{
+			const size_t index = mHash.GetRandomIndexOfBatchHash(i);
+			const std::array<float, VECTOR_SIZE>& diagonalVector = DIAGONAL_VECTORS[index % DIAGONAL_VECTORS.size()];
+
+			int packedDiagonalVector = 0;
+			for (int j = 0; j < N; ++j)
+			{
+				packedDiagonalVector |= ((int)diagonalVector[j] + 1) << (2 * j);
+			}
+			mBatchDiagonalVectors[i] = packedDiagonalVector;
+		}
+	}
+private:
+	static constexpr auto DIAGONAL_VECTORS = noise::CreateDiagonalVectors<VECTOR_SIZE>();
+
+	// (sqrt(N + 1) - 1) / N and (1 - 1 / sqrt(N + 1)) / N, which turn the hypercube lattice
+	// into a lattice of simplices and back again
+	static constexpr float SKEW_FACTOR = (float)((SquareRoot(N + 1.0) - 1.0) / N);
+	static constexpr float UNSKEW_FACTOR = (float)((1.0 - 1.0 / SquareRoot(N + 1.0)) / N);
+	// The squared distance at which the contribution of a corner reaches 0. A larger radius
+	// would make the contributions reach past the simplex, which causes discontinuities.
+	static constexpr float RADIUS_SQUARED = 0.5f;
+	// Scales the sum of the contributions to range between -1 and 1
+	static constexpr float SCALE = N == 2 ? 70.0f : N == 3 ? 76.0f : 62.0f;
+
+	HashT mHash;
+
+	// The diagonal vector of every batch hash, packed into an int and laid out for "GetMany"
+	std::array<int, HashT::BATCH_HASH_COUNT> mBatchDiagonalVectors;
+};
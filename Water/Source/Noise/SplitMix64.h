@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+
+namespace noise
+{
+	// The seed of the noise tables, unless another one is given. A fixed seed makes the noise,
+	// and everything that is baked from it, identical from run to run.
+	constexpr uint64_t DEFAULT_SEED = 0x5EED;
+
+	// A small, seedable random number generator that can run at compile time, unlike the
+	// engines of <random>. Every seed gives its own sequence on every compiler and platform.
+	class SplitMix64
+	{
+	public:
+		constexpr explicit SplitMix64(const uint64_t seed)
+			:
+			mState(seed)
+		{}
+		constexpr uint64_t Next()
+		{
+			mState += 0x9E3779B97F4A7C15;
+			uint64_t value = mState;
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+			return value ^ (value >> 31);
+		}
+		// Returns a value in [0, bound), without the bias of a plain modulo
+		constexpr uint64_t NextBelow(const uint64_t bound)
+		{
+			assert(bound > 0);
+			// The values below "threshold" would make the low values more likely than the high ones
+			const uint64_t threshold = (0 - bound) % bound;
+			uint64_t value = Next();
+			while (value < threshold)
+			{
+				value = Next();
+			}
+			return value % bound;
+		}
+		// Returns a value in [0, 1)
+		constexpr float NextFloat()
+		{
+			// A float has 24 bits of precision
+			return (float)(Next() >> 40) * (1.0f / (float)(1 << 24));
+		}
+	private:
+		uint64_t mState;
+	};
+}
@@ -3,144 +3,156 @@
 #include "../Mathematics/Vector/Vector.h"
 #include "../Mathematics/Algorithms.h"
 #include "RandomValueTable.h"
-#include "PermutationTable.h"
+#include "NoiseHash.h"
+#include "NoiseCorners.h"
+#include "NoiseBatch.h"
 #include "../CustomConcepts.h"
 
-template<int N, int N_RANDOM_VALUES = 256>
+// "HashT" hashes the corners of the lattice, e.g., "noise::PermutationHash" or "noise::IntegerHash"
+template<int N, int N_RANDOM_VALUES = 256, class HashT = noise::PermutationHash<N_RANDOM_VALUES>>
 // N_RANDOM_VALUES needs to be a power of two, since we need to use the &-operator instead
 // of the %-operator
 requires(IsPowerOfTwo(N_RANDOM_VALUES))
 class ValueNoise
 {
 public:
-	ValueNoise(const std::shared_ptr<RandomValueTable<N_RANDOM_VALUES>> randomValues, 
-		const std::shared_ptr<PermutationTable<N_RANDOM_VALUES>> permutationTable)
+	// A shared pointer to a permutation table converts to the default "HashT"
+	ValueNoise(const std::shared_ptr<const RandomValueTable<N_RANDOM_VALUES>> randomValues, const HashT& hash)
 		:
 		mRandomValues(randomValues),
-		mPermutationTable(permutationTable)
+		mHash(hash)
 	{
-		InitializeCornerOffets();
+		InitializeBatchTables();
 	}
 
 	float Get(const BasicVector<float, N>& position) const
 	{
-		// The floored integer position of the input vector 
-		BasicVector<int, N> location;
-		std::transform(position.begin(), position.end(), location.begin(),
-			[](float value)
+		// The floored integer position of the input vector
+		std::array<int, N> location;
+		// The amounts that we should interpolate between the random values with
+		std::array<float, N> interpolationAmounts;
+		for (int i = 0; i < N; ++i)
+		{
+			const float flooredValue = std::floor(position[i]);
+			location[i] = (int)flooredValue;
+			interpolationAmounts[i] = Smoothstep(position[i] - flooredValue);
+		}
+
+		// Contains the random corner values
+		std::array<float, N_CORNERS> cornerValues;
+		noise::ForEachCorner<N>([&](auto corner)
 			{
-				return (int)std::floor(value);
+				constexpr std::array<int, N> cornerOffset = CORNER_OFFSETS[corner];
+
+				// The location of the corner. We need to apply the modulo-operator, in
+				// order to not exceed the size of the permutation table.
+				std::array<int, N> cornerLocation;
+				for (int i = 0; i < N; ++i)
+				{
+					cornerLocation[i] = ApplyModulo(location[i] + cornerOffset[i]);
+				}
+
+				cornerValues[corner] = (*mRandomValues)[mHash.template GetRandomIndex<N>(cornerLocation)];
 			});
 
-		// The amounts that we should interpolate between the random values with
-		BasicVector<float, N> interpolationAmounts;
-		std::transform(position.begin(), position.end(), location.begin(), interpolationAmounts.begin(),
-			[this](float value, int flooredValue)
+		// Interpolate between the "cornerValues" based on the "interpolationAmounts"
+		return noise::InterpolateCorners(cornerValues, interpolationAmounts,
+			[](float a, float b, float amount)
 			{
-				return Smoothstep(value - (float)flooredValue);
+				return Lerp(a, b, amount);
 			});
+	}
+	// Evaluates "Get" for a batch of positions, using the widest instruction set that the CPU supports
+	void GetMany(const noise::Positions<N>& positions, std::span<float> out) const
+	{
+		noise::EvaluateMany<N>(*this, positions, out);
+	}
+	void GetMany(std::span<const float> xs, std::span<const float> ys, std::span<float> out) const
+	requires(N == 2)
+	{
+		GetMany({ xs, ys }, out);
+	}
+	void GetMany(std::span<const float> xs, std::span<const float> ys, std::span<const float> zs, std::span<float> out) const
+	requires(N == 3)
+	{
+		GetMany({ xs, ys, zs }, out);
+	}
+	// Evaluates "Simd::WIDTH" positions at once. Gives the same result as "Get", apart from
+	// the rounding of the fused multiply-adds.
+	template<class Simd>
+	typename Simd::Float Evaluate(const std::array<typename Simd::Float, N>& position) const
+	{
+		using Float = typename Simd::Float;
+		using Int = typename Simd::Int;
 
-		// Contains the random corner values
-		float cornerValues[N_CORNERS];
-		for (int i = 0; i < N_CORNERS; ++i)
+		const Int mask = Simd::SetInt(N_RANDOM_VALUES - 1);
+
+		// The wrapped locations for a corner offset of 0 and 1 respectively
+		std::array<std::array<Int, 2>, N> locations;
+		std::array<Float, N> interpolationAmounts;
+		for (int i = 0; i < N; ++i)
 		{
-			// The location of the i-th corner
-			BasicVector<int, N> cornerLocation = mCornerOffsets[i] + location;
-			// We need to apply the modulo-operator, in order to not exceed the size
-			// of the permutation table
-			ApplyModulo(cornerLocation);
+			const Float floored = Simd::Floor(position[i]);
+			const Int location = Simd::ToInt(floored);
 
-			cornerValues[i] = (*mRandomValues)[GetRandomIndex(cornerLocation)];
+			locations[i] = { Simd::AndInt(location, mask), Simd::AndInt(Simd::AddInt(location, Simd::SetInt(1)), mask) };
+			interpolationAmounts[i] = Smoothstep<Simd>(Simd::Sub(position[i], floored));
 		}
 
-		// Interpolate between the "cornerValues" based on the "interpolationAmounts"
-		return Interpolate(cornerValues, interpolationAmounts);
+		const std::array<Int, N_CORNERS> batchHashes = mHash.template GetBatchHashes<Simd, N>(locations);
+
+		std::array<Float, N_CORNERS> cornerValues;
+		noise::ForEachCorner<N>([&](auto corner)
+			{
+				// The last step of the hash is merged with the lookup of the random value
+				cornerValues[corner] = Simd::Gather(mBatchRandomValues.data(), batchHashes[corner]);
+			});
+
+		return noise::InterpolateCorners(cornerValues, interpolationAmounts,
+			[](Float a, Float b, Float amount)
+			{
+				return Simd::MulAdd(Simd::Sub(b, a), amount, a);
+			});
 	}
+
+	static constexpr int DIMENSION = N;
 private:
-	float Interpolate(float* cornerValues, const BasicVector<float, N>& interpolationAmounts) const
+	template<class Simd>
+	static typename Simd::Float Smoothstep(typename Simd::Float t)
 	{
-		auto end = cornerValues + N_CORNERS;
-		for (auto interpolationAmount : interpolationAmounts)
-		{
-			auto currentDestination = cornerValues;
-			for (auto iterator = cornerValues; iterator != end; std::advance(iterator, 2), ++currentDestination)
-			{
-				// Interpolate between the adjacent corner values
-				*currentDestination = Lerp(*iterator, *(iterator + 1), interpolationAmount);
-			}
-			// Set the end to be the iterator pointing to the result of the last interpolation + 1,
-			// effectively cutting the amount of corner values in half after each "interpolationAmount"-loop
-			end = currentDestination;
-		}
-
-		return cornerValues[0];
+		// t * t * (3.0f - 2.0f * t)
+		return Simd::Mul(Simd::Mul(t, t), Simd::MulAdd(t, Simd::Set(-2.0f), Simd::Set(3.0f)));
 	}
-	size_t GetRandomIndex(const BasicVector<int, N>& location) const
+	void InitializeBatchTables()
 	{
-		size_t index = 0;
-		// Combine all of the location's elements into one index, effectively
-		// hashing the location
-		for (int i = 0; i < N; ++i)
+		// Looking up the random value directly by the batch hash saves a dependent load per corner
+		for (size_t i = 0; i < mBatchRandomValues.size(); ++i)
 		{
-			index = (*mPermutationTable)[location[i] + index];
+			mBatchRandomValues[i] = (*mRandomValues)[mHash.GetRandomIndexOfBatchHash(i)];
 		}
-
-		return index;
 	}
-	float Smoothstep(float t) const
+	static float Smoothstep(float t)
 	{
 		return t * t * (3.0f - 2.0f * t);
 	}
-	void ApplyModulo(BasicVector<int, N>& location) const
+	static int ApplyModulo(int value)
 	{
-		// We apply the &-operator to the location, which is the same (as long as 
-		// we subtract 1 from the value, e.g., "N_RANDOM_VALUES - 1") as 
+		// We apply the &-operator to the value, which is the same (as long as
+		// we subtract 1 from the value, e.g., "N_RANDOM_VALUES - 1") as
 		// applying the %-operator for positive values since "N_RANDOM_VALUES" is a
 		// power of 2
-		std::for_each(location.begin(), location.end(),
-			[](int& value)
-			{
-				value = int(value & (N_RANDOM_VALUES - 1));
-			});
-	}
-	void InitializeCornerOffets()
-	{
-		int moduloValues[N];
-		for (int i = 0; i < N; ++i)
-		{
-			// The moduloValue decides how often the corresponding element
-			// inside the diagonal vectors changes from 0 to 1. 
-			// For i = 0, we get a modulo value of 2 ^ (0 + 1) = 2,
-			// which means that the first (0) element is going to be 0 for 2 / 2 = 1 diagonalVectors
-			// in a row. For i = 2, we get a modulo value of 2 ^ (2 + 1) = 8,
-			// which means that the third (2) element is going to be 0 for 8 / 2 = 4 diagonalVectors
-			// in a row, etc.
-			moduloValues[i] = (int)std::pow(2.0, (double)i + 1);
-		}
-
-		for (int i = 0; i < N_CORNERS; ++i)
-		{
-			BasicVector<int, N> cornerOffset;
-			for (int j = 0; j < N; ++j)
-			{
-				int moduloValue = moduloValues[j];
-				// We can use a &-operator instead of the %-operator since moduloValue is
-				// by definition a power of 2 (note that we then need to subtract 1 from
-				// the modulo value: "moduloValue - 1"
-				cornerOffset[j] = ((i & (moduloValue - 1)) < moduloValue / 2) ? 0 : 1;
-			}
-			mCornerOffsets.push_back(cornerOffset);
-		}
+		return value & (N_RANDOM_VALUES - 1);
 	}
 private:
 	static constexpr size_t N_CORNERS = Power(2, N);
+	static constexpr noise::CornerOffsets<N> CORNER_OFFSETS = noise::CreateCornerOffsets<N>();
 
-	// Store the permutation table and the random values as shared pointers so that we do not have to
-	// allocate a new permutation table and new random values for every instance of this class. Instances of
-	// ValueNoise<2> and ValueNoise<3> can now for example share the same
-	// permutation table and random values.
-	std::shared_ptr<RandomValueTable<N_RANDOM_VALUES>> mRandomValues;
-	std::shared_ptr<PermutationTable<N_RANDOM_VALUES>> mPermutationTable;
+	// Store the random values as a shared pointer so that we do not have to
+	// allocate new random values for every instance of this class. Instances of
+	// ValueNoise<2> and ValueNoise<3> can now for example share the same random values.
+	std::shared_ptr<const RandomValueTable<N_RANDOM_VALUES>> mRandomValues;
+	HashT mHash;
 
-	std::vector<BasicVector<int, N>> mCornerOffsets;
+	// The random value of every batch hash, laid out for "GetMany"
+	std::array<float, HashT::BATCH_HASH_COUNT> mBatchRandomValues;
 };
\ No newline at end of file
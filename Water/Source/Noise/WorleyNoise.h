@@ -0,0 +1,272 @@
+#pragma once
+
+#include "../Mathematics/Vector/Vector.h"
+#include "../Mathematics/Algorithms.h"
+#include "NoiseHash.h"
+#include "NoiseCorners.h"
+#include "NoiseBatch.h"
+#include "../CustomConcepts.h"
+#include <limits>
+
+enum class WorleyMetric
+{
+	// The straight-line distance, which gives round cells
+	Euclidean,
+	// The sum of the distances along every axis, which gives diamond-shaped cells
+	Manhattan,
+	// The largest distance along any axis, which gives square cells
+	Chebyshev
+};
+
+enum class WorleyOutput
+{
+	// The distance to the closest feature point, e.g., for caustics
+	F1,
+	// The distance to the second closest feature point
+	F2,
+	// Zero on the edges between the cells, e.g., for foam
+	F2MinusF1
+};
+
+struct WorleySettings
+{
+	WorleyMetric metric = WorleyMetric::Euclidean;
+	WorleyOutput output = WorleyOutput::F1;
+	// How far the feature points may stray from the centers of their cells, between 0 (a regular grid) and 1
+	float jitter = 1.0f;
+};
+
+// Cellular noise. Every cell of the lattice contains a feature point at a random position, and the noise
+// returns the distance from the sampled position to the closest (F1) or the second closest (F2) feature
+// point. Only the 3 ^ N cells around the sampled position are searched, which always finds F1 since a feature
+// point never leaves its cell. F2 can, very rarely, miss a feature point that lies two cells away.
+// "HashT" hashes the cells, e.g., "noise::PermutationHash" or "noise::IntegerHash".
+template<int N, int N_RANDOM_VALUES = 256, class HashT = noise::PermutationHash<N_RANDOM_VALUES>>
+// N_RANDOM_VALUES needs to be a power of two, since we need to use the &-operator instead
+// of the %-operator. The feature points are packed into 8 bits per dimension, which
+// limits N to 4.
+requires(IsPowerOfTwo(N_RANDOM_VALUES) && N >= 2 && N <= 4)
+class WorleyNoise
+{
+public:
+	// A shared pointer to a permutation table converts to the default "HashT"
+	WorleyNoise(const HashT& hash, const WorleySettings& settings = {})
+		:
+		mHash(hash),
+		mMetric(settings.metric),
+		mOutput(settings.output),
+		// Spreads the 256 steps of a packed coordinate evenly around the center of the cell
+		mFeaturePointScale(settings.jitter / 256.0f),
+		mFeaturePointBase(0.5f - 127.5f * settings.jitter / 256.0f)
+	{
+		assert(settings.jitter >= 0.0f && settings.jitter <= 1.0f);
+
+		// Looking up the feature point directly by the batch hash saves a dependent load per cell
+		for (size_t i = 0; i < mBatchFeaturePoints.size(); ++i)
+		{
+			mBatchFeaturePoints[i] = (int)noise::MixBits((uint32_t)mHash.GetRandomIndexOfBatchHash(i));
+		}
+	}
+
+	float Get(const BasicVector<float, N>& position) const
+	{
+		// The floored integer position of the input vector
+		std::array<int, N> location;
+		// The position relative to the cell that contains it
+		std::array<float, N> fraction;
+		for (int i = 0; i < N; ++i)
+		{
+			const float flooredValue = std::floor(position[i]);
+			location[i] = (int)flooredValue;
+			fraction[i] = position[i] - flooredValue;
+		}
+
+		float f1 = std::numeric_limits<float>::max();
+		float f2 = std::numeric_limits<float>::max();
+		for (const std::array<int, N>& neighbourOffset : NEIGHBOUR_OFFSETS)
+		{
+			// The location of the neighbour. We need to apply the modulo-operator, in
+			// order to not exceed the size of the permutation table.
+			std::array<int, N> neighbourLocation;
+			for (int i = 0; i < N; ++i)
+			{
+				neighbourLocation[i] = ApplyModulo(location[i] + neighbourOffset[i]);
+			}
+			const uint32_t featurePoint = noise::MixBits((uint32_t)mHash.template GetRandomIndex<N>(neighbourLocation));
+
+			float distance = 0.0f;
+			for (int i = 0; i < N; ++i)
+			{
+				const float packedCoordinate = (float)((featurePoint >> (8 * i)) & 255);
+				const float delta = std::abs(packedCoordinate * mFeaturePointScale +
+					((float)neighbourOffset[i] + mFeaturePointBase) - fraction[i]);
+				switch (mMetric)
+				{
+				case WorleyMetric::Euclidean:
+					distance += delta * delta;
+					break;
+				case WorleyMetric::Manhattan:
+					distance += delta;
+					break;
+				case WorleyMetric::Chebyshev:
+					distance = std::max(distance, delta);
+					break;
+				}
+			}
+
+			f2 = std::min(f2, std::max(f1, distance));
+			f1 = std::min(f1, distance);
+		}
+
+		// The Euclidean distances are compared squared, which saves a square root per cell
+		if (mMetric == WorleyMetric::Euclidean)
+		{
+			f1 = std::sqrt(f1);
+			f2 = std::sqrt(f2);
+		}
+		return SelectOutput(f1, f2);
+	}
+	// Evaluates "Get" for a batch of positions, using the widest instruction set that the CPU supports
+	void GetMany(const noise::Positions<N>& positions, std::span<float> out) const
+	{
+		noise::EvaluateMany<N>(*this, positions, out);
+	}
+	void GetMany(std::span<const float> xs, std::span<const float> ys, std::span<float> out) const
+	requires(N == 2)
+	{
+		GetMany({ xs, ys }, out);
+	}
+	void GetMany(std::span<const float> xs, std::span<const float> ys, std::span<const float> zs, std::span<float> out) const
+	requires(N == 3)
+	{
+		GetMany({ xs, ys, zs }, out);
+	}
+	// Evaluates "Simd::WIDTH" positions at once. Gives the same result as "Get", apart from
+	// the rounding of the fused multiply-adds.
+	template<class Simd>
+	typename Simd::Float Evaluate(const std::array<typename Simd::Float, N>& position) const
+	{
+		// Branch on the metric once per batch, instead of once per cell
+		switch (mMetric)
+		{
+		case WorleyMetric::Manhattan:
+			return EvaluateWithMetric<Simd, WorleyMetric::Manhattan>(position);
+		case WorleyMetric::Chebyshev:
+			return EvaluateWithMetric<Simd, WorleyMetric::Chebyshev>(position);
+		default:
+			return EvaluateWithMetric<Simd, WorleyMetric::Euclidean>(position);
+		}
+	}
+
+	static constexpr int DIMENSION = N;
+private:
+	template<class Simd, WorleyMetric METRIC>
+	typename Simd::Float EvaluateWithMetric(const std::array<typename Simd::Float, N>& position) const
+	{
+		using Float = typename Simd::Float;
+		using Int = typename Simd::Int;
+
+		const Int mask = Simd::SetInt(N_RANDOM_VALUES - 1);
+
+		// The wrapped locations for a neighbour offset of -1, 0 and 1 respectively
+		std::array<std::array<Int, 3>, N> locations;
+		std::array<Float, N> fraction;
+		for (int i = 0; i < N; ++i)
+		{
+			const Float floored = Simd::Floor(position[i]);
+			const Int location = Simd::ToInt(floored);
+
+			locations[i] = { Simd::AndInt(Simd::SubInt(location, Simd::SetInt(1)), mask), Simd::AndInt(location, mask),
+				Simd::AndInt(Simd::AddInt(location, Simd::SetInt(1)), mask) };
+			fraction[i] = Simd::Sub(position[i], floored);
+		}
+
+		const std::array<Int, N_NEIGHBOURS> batchHashes = mHash.template GetBatchHashes<Simd, N, 3>(locations);
+
+		const Float scale = Simd::Set(mFeaturePointScale);
+		// "neighbourOffset + mFeaturePointBase" for every neighbour offset
+		const std::array<Float, 3> bases = { Simd::Set(mFeaturePointBase - 1.0f), Simd::Set(mFeaturePointBase),
+			Simd::Set(mFeaturePointBase + 1.0f) };
+
+		Float f1 = Simd::Set(std::numeric_limits<float>::max());
+		Float f2 = f1;
+		noise::ForEachIndex<N_NEIGHBOURS>([&](auto neighbour)
+			{
+				constexpr std::array<int, N> neighbourOffset = NEIGHBOUR_OFFSETS[neighbour];
+
+				// The last step of the hash is merged with the lookup of the feature point
+				const Int featurePoint = Simd::Gather(mBatchFeaturePoints.data(), batchHashes[neighbour]);
+
+				Float distance = Simd::Set(0.0f);
+				for (int i = 0; i < N; ++i)
+				{
+					const Float packedCoordinate = Simd::ToFloat(Simd::AndInt(Simd::ShiftRightLogicalInt(featurePoint, 8 * i), Simd::SetInt(255)));
+					const Float delta = Simd::Abs(Simd::Sub(Simd::MulAdd(packedCoordinate, scale, bases[neighbourOffset[i] + 1]), fraction[i]));
+					if constexpr (METRIC == WorleyMetric::Euclidean)
+					{
+						distance = Simd::MulAdd(delta, delta, distance);
+					}
+					else if constexpr (METRIC == WorleyMetric::Manhattan)
+					{
+						distance = Simd::Add(distance, delta);
+					}
+					else
+					{
+						distance = Simd::Max(distance, delta);
+					}
+				}
+
+				f2 = Simd::Min(f2, Simd::Max(f1, distance));
+				f1 = Simd::Min(f1, distance);
+			});
+
+		if constexpr (METRIC == WorleyMetric::Euclidean)
+		{
+			f1 = Simd::Sqrt(f1);
+			f2 = Simd::Sqrt(f2);
+		}
+		switch (mOutput)
+		{
+		case WorleyOutput::F2:
+			return f2;
+		case WorleyOutput::F2MinusF1:
+			return Simd::Sub(f2, f1);
+		default:
+			return f1;
+		}
+	}
+	float SelectOutput(float f1, float f2) const
+	{
+		switch (mOutput)
+		{
+		case WorleyOutput::F2:
+			return f2;
+		case WorleyOutput::F2MinusF1:
+			return f2 - f1;
+		default:
+			return f1;
+		}
+	}
+	static int ApplyModulo(int value)
+	{
+		// We apply the &-operator to the value, which is the same (as long as
+		// we subtract 1 from the value, e.g., "N_RANDOM_VALUES - 1") as
+		// applying the %-operator for positive values since "N_RANDOM_VALUES" is a
+		// power of 2
+		return value & (N_RANDOM_VALUES - 1);
+	}
+private:
+	static constexpr size_t N_NEIGHBOURS = Power(3, N);
+	static constexpr noise::NeighbourOffsets<N> NEIGHBOUR_OFFSETS = noise::CreateNeighbourOffsets<N>();
+
+	HashT mHash;
+	WorleyMetric mMetric;
+	WorleyOutput mOutput;
+	// A packed coordinate "q" of a feature point lies at "q * mFeaturePointScale + mFeaturePointBase"
+	// within its cell
+	float mFeaturePointScale;
+	float mFeaturePointBase;
+
+	// The feature point of every batch hash, with 8 bits per dimension, laid out for "GetMany"
+	std::array<int, HashT::BATCH_HASH_COUNT> mBatchFeaturePoints;
+};
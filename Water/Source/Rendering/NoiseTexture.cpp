@@ -0,0 +1,48 @@
+#include "NoiseTexture.h"
+#include "GlMacro.h"
+
+NoiseTexture::NoiseTexture(const int dimension, const int resolution, const std::vector<float>& texels)
+{
+	assert(dimension == 2 || dimension == 3);
+	assert(texels.size() == (size_t)std::pow(resolution, dimension) * (dimension + 1));
+
+	// Every mipmap level halves the resolution, down to a single texel
+	GLsizei nMipmapLevels = 1;
+	while ((resolution >> nMipmapLevels) > 0)
+	{
+		++nMipmapLevels;
+	}
+
+	// Half floats are precise enough for values between 0 and 1 and gradients of about the same size
+	if (dimension == 2)
+	{
+		GL(glCreateTextures(GL_TEXTURE_2D, 1, &mTextureName));
+		GL(glTextureStorage2D(mTextureName, nMipmapLevels, GL_RGB16F, resolution, resolution));
+		GL(glTextureSubImage2D(mTextureName, 0, 0, 0, resolution, resolution, GL_RGB, GL_FLOAT, texels.data()));
+	}
+	else
+	{
+		GL(glCreateTextures(GL_TEXTURE_3D, 1, &mTextureName));
+		GL(glTextureStorage3D(mTextureName, nMipmapLevels, GL_RGBA16F, resolution, resolution, resolution));
+		GL(glTextureSubImage3D(mTextureName, 0, 0, 0, 0, resolution, resolution, resolution, GL_RGBA, GL_FLOAT, texels.data()));
+	}
+	GL(glGenerateTextureMipmap(mTextureName));
+
+	// The noise was baked to be tileable
+	GL(glTextureParameteri(mTextureName, GL_TEXTURE_WRAP_S, GL_REPEAT));
+	GL(glTextureParameteri(mTextureName, GL_TEXTURE_WRAP_T, GL_REPEAT));
+	GL(glTextureParameteri(mTextureName, GL_TEXTURE_WRAP_R, GL_REPEAT));
+	GL(glTextureParameteri(mTextureName, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR));
+	GL(glTextureParameteri(mTextureName, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+}
+
+NoiseTexture::~NoiseTexture()
+{
+	// Destructors should not throw exception, hence no GL macro
+	glDeleteTextures(1, &mTextureName);
+}
+
+void NoiseTexture::Bind(const GLuint unit) const
+{
+	GL(glBindTextureUnit(unit, mTextureName));
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include "GL/glew.h"
+
+// A 2D or 3D texture that holds noise baked by "noise::BakeTileable", which lets the shaders replace
+// a noise evaluation with a single filtered fetch. The value is stored in the red channel and the
+// gradient in the following channels. The texture repeats and has a full chain of mipmaps.
+class NoiseTexture
+{
+public:
+	// "texels" holds "dimension" + 1 floats per texel, for "resolution" ^ "dimension" texels
+	NoiseTexture(int dimension, int resolution, const std::vector<float>& texels);
+	~NoiseTexture();
+	void Bind(GLuint unit) const;
+private:
+	GLuint mTextureName = 0;
+};
@@ -1,6 +1,7 @@
 #include "PostProcessor.h"
 #include "../Window/Window.h"
 #include "GlMacro.h"
+#include "../Benchmark/BenchmarkMacros.h"
 
 PostProcessor::PostProcessor(std::function<void()> renderingFunction)
 	:
@@ -69,6 +70,9 @@ void PostProcessor::StopRenderingIntoTexture() const
 
 void PostProcessor::RenderTextureWithEffect(const std::string& effect) const
 {
+	BENCHMARK_FRAME_PHASE(PostProcess);
+	GPU_BENCHMARK("GPU post-process");
+
 	// Make sure that the effect has been added
 	assert(mNameToEffect.find(effect) != mNameToEffect.end());
 
@@ -18,7 +18,8 @@ struct Vertex
 	// The reason why we can not use the normal vector class, is
 	// because it inherits from "ContainerBase". Two instances, of the 
 	// normal vector class, stored next to each other in memory will, 
-	// thanks to the inheritance, have padding between their data.
+	// in debug builds, have padding between their data. "Vector3" is
+	// also padded to 16 bytes in every build, so that it fills an SSE register.
 	TightlyPackedVector3 position;
 	Uv uv;
 	TightlyPackedVector3 normal;
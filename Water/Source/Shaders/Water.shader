@@ -82,8 +82,8 @@ layout(fractional_even_spacing) in;
 layout(location = 0) uniform vec3 cameraPosition;
 layout(location = 1) uniform mat4 rotationMatrix;
 layout(location = 2) uniform mat4 projectionMatrix;
-layout(location = 5) uniform float[8] waterFactors;
-layout(location = 13) uniform float time;
+layout(location = 5) uniform float[9] waterFactors;
+layout(location = 14) uniform float time;
 
 // Perlin noise
 layout(binding = 0) uniform usampler1D permutationTable;
@@ -93,55 +93,61 @@ float Smoothstep(float t)
 {
 	return t * t * t * (10.0 + t * (6.0 * t - 15.0));
 }
+// Needs to match "noise::IntegerHash::GetSeed" on the CPU
+layout(location = 16) uniform uint integerHashSeed;
+
 int AccessPermutationTable(int index)
 {
 	return int(texelFetch(permutationTable, index, 0).r);
 }
+// The same as "noise::MixBits" on the CPU
+uint MixBits(uint value)
+{
+	value ^= value >> 16;
+	value *= 0x7FEB352Du;
+	value ^= value >> 15;
+	value *= 0x846CA68Bu;
+	value ^= value >> 16;
+	return value;
+}
+// The same hash as "noise::IntegerHash" on the CPU. Only uses arithmetic, so unlike the
+// permutation table, it does not wait for three dependent texel fetches.
+uint GetIntegerHash(const ivec3 location)
+{
+	return MixBits(integerHashSeed ^ (uint(location.x) * 0x8DA6B343u) ^ (uint(location.y) * 0xD8163841u) ^ (uint(location.z) * 0xCB1AB31Fu));
+}
 uint GetRandomIndex(const ivec3 location)
 {
+	// Selects between the integer hash and the permutation table
+	bool useIntegerHash = waterFactors[7] >= 0.5;
+	if (useIntegerHash)
+	{
+		return GetIntegerHash(location) & uint(N_RANDOM_VALUES - 1);
+	}
 	return AccessPermutationTable(AccessPermutationTable(AccessPermutationTable(location.x) + location.y) + location.z);
 }
-float GetRandomPerlinValue(const uint index, const vec3 toPosition)
+float SmoothstepDerivative(float t)
+{
+	return 30.0 * t * t * (t * (t - 2.0) + 1.0);
+}
+// The same diagonal vectors, in the same order, as "noise::CreateDiagonalVectors<3>" on the CPU, which
+// "PerlinNoise<3>" and "SimplexNoise<3>" pick from with the random index modulo 12
+vec3 GetDiagonalVector(const uint index)
 {
-	switch (index & 15)
+	uint diagonalIndex = index % 12u;
+	vec2 signs = vec2((diagonalIndex & 1u) != 0u ? -1.0 : 1.0, (diagonalIndex & 2u) != 0u ? -1.0 : 1.0);
+	switch (diagonalIndex / 4u)
 	{
-	case 0:
-		return toPosition.x + toPosition.y;
-	case 1:
-		return toPosition.x - toPosition.y;
-	case 2:
-		return -toPosition.x + toPosition.y;
-	case 3:
-		return -toPosition.x - toPosition.y;
-	case 4:
-		return toPosition.y + toPosition.z;
-	case 5:
-		return toPosition.y - toPosition.z;
-	case 6:
-		return -toPosition.y + toPosition.z;
-	case 7:
-		return -toPosition.y - toPosition.z;
-	case 8:
-		return toPosition.x + toPosition.z;
-	case 9:
-		return toPosition.x - toPosition.z;
-	case 10:
-		return -toPosition.x + toPosition.z;
-	case 11:
-		return -toPosition.x - toPosition.z;
-	case 12:
-		return toPosition.x + toPosition.z;
-	case 13:
-		return toPosition.x - toPosition.z;
-	case 14:
-		return -toPosition.x + toPosition.z;
-	case 15:
-		return -toPosition.x - toPosition.z;
+	case 0u:
+		return vec3(0.0, signs.x, signs.y);
+	case 1u:
+		return vec3(signs.x, 0.0, signs.y);
 	default:
-		return -1.0;
+		return vec3(signs.x, signs.y, 0.0);
 	}
 }
-float PerlinNoise(const vec3 position)
+// Returns the Perlin noise value in x and its partial derivatives in yzw
+vec4 PerlinNoiseWithGradient(const vec3 position)
 {
 	int fx = int(floor(position.x));
 	int fy = int(floor(position.y));
@@ -163,27 +169,107 @@ float PerlinNoise(const vec3 position)
 	float sy = Smoothstep(ty);
 	float sz = Smoothstep(tz);
 
-	float c000 = GetRandomPerlinValue(GetRandomIndex(ivec3(x0, y0, z0)), vec3(tx, ty, tz));
-	float c100 = GetRandomPerlinValue(GetRandomIndex(ivec3(x1, y0, z0)), vec3(tx - 1, ty, tz));
-
-	float c001 = GetRandomPerlinValue(GetRandomIndex(ivec3(x0, y0, z1)), vec3(tx, ty, tz - 1));
-	float c101 = GetRandomPerlinValue(GetRandomIndex(ivec3(x1, y0, z1)), vec3(tx - 1, ty, tz - 1));
-
-	float c010 = GetRandomPerlinValue(GetRandomIndex(ivec3(x0, y1, z0)), vec3(tx, ty - 1, tz));
-	float c110 = GetRandomPerlinValue(GetRandomIndex(ivec3(x1, y1, z0)), vec3(tx - 1, ty - 1, tz));
-
-	float c011 = GetRandomPerlinValue(GetRandomIndex(ivec3(x0, y1, z1)), vec3(tx, ty - 1, tz - 1));
-	float c111 = GetRandomPerlinValue(GetRandomIndex(ivec3(x1, y1, z1)), vec3(tx - 1, ty - 1, tz - 1));
-
-	float perlinValue = mix(
-		mix(mix(c000, c100, sx), mix(c010, c110, sx), sy),
-		mix(mix(c001, c101, sx), mix(c011, c111, sx), sy),
+	vec3 g000 = GetDiagonalVector(GetRandomIndex(ivec3(x0, y0, z0)));
+	vec3 g100 = GetDiagonalVector(GetRandomIndex(ivec3(x1, y0, z0)));
+	vec3 g001 = GetDiagonalVector(GetRandomIndex(ivec3(x0, y0, z1)));
+	vec3 g101 = GetDiagonalVector(GetRandomIndex(ivec3(x1, y0, z1)));
+	vec3 g010 = GetDiagonalVector(GetRandomIndex(ivec3(x0, y1, z0)));
+	vec3 g110 = GetDiagonalVector(GetRandomIndex(ivec3(x1, y1, z0)));
+	vec3 g011 = GetDiagonalVector(GetRandomIndex(ivec3(x0, y1, z1)));
+	vec3 g111 = GetDiagonalVector(GetRandomIndex(ivec3(x1, y1, z1)));
+
+	float c000 = dot(g000, vec3(tx, ty, tz));
+	float c100 = dot(g100, vec3(tx - 1, ty, tz));
+	float c001 = dot(g001, vec3(tx, ty, tz - 1));
+	float c101 = dot(g101, vec3(tx - 1, ty, tz - 1));
+	float c010 = dot(g010, vec3(tx, ty - 1, tz));
+	float c110 = dot(g110, vec3(tx - 1, ty - 1, tz));
+	float c011 = dot(g011, vec3(tx, ty - 1, tz - 1));
+	float c111 = dot(g111, vec3(tx - 1, ty - 1, tz - 1));
+
+	float c00 = mix(c000, c100, sx);
+	float c10 = mix(c010, c110, sx);
+	float c01 = mix(c001, c101, sx);
+	float c11 = mix(c011, c111, sx);
+	float c0 = mix(c00, c10, sy);
+	float c1 = mix(c01, c11, sy);
+	float perlinValue = mix(c0, c1, sz);
+
+	// The corner values are dot products with the gradients, so the gradients get interpolated in
+	// the same way. The interpolation amounts also change along their own dimension.
+	vec3 gradient = mix(
+		mix(mix(g000, g100, sx), mix(g010, g110, sx), sy),
+		mix(mix(g001, g101, sx), mix(g011, g111, sx), sy),
 		sz
 	);
-	return (perlinValue + 1.0) / 2.0;
+	gradient += vec3(SmoothstepDerivative(tx), SmoothstepDerivative(ty), SmoothstepDerivative(tz)) * vec3(
+		mix(mix(c100 - c000, c110 - c010, sy), mix(c101 - c001, c111 - c011, sy), sz),
+		mix(c10 - c00, c11 - c01, sz),
+		c1 - c0
+	);
+	return vec4(perlinValue + 1.0, gradient) / 2.0;
+}
+float PerlinNoise(const vec3 position)
+{
+	// The unused gradient gets optimized away
+	return PerlinNoiseWithGradient(position).x;
 }
 // End of Perlin noise
 
+// Simplex noise, which gives the same values as "SimplexNoise<3>" on the CPU. Uses the
+// permutation table of the Perlin noise, but only evaluates 4 corners instead of 8.
+const float SKEW_FACTOR = 1.0 / 3.0;
+const float UNSKEW_FACTOR = 1.0 / 6.0;
+const float SIMPLEX_RADIUS_SQUARED = 0.5;
+const float SIMPLEX_SCALE = 76.0;
+
+// Returns the contribution of the corner in x and its partial derivatives in yzw
+vec4 GetSimplexCornerValue(const ivec3 location, const vec3 toPosition)
+{
+	vec3 diagonalVector = GetDiagonalVector(GetRandomIndex(location & (N_RANDOM_VALUES - 1)));
+	float falloff = max(SIMPLEX_RADIUS_SQUARED - dot(toPosition, toPosition), 0.0);
+	float falloffSquared = falloff * falloff;
+	float cornerDot = dot(diagonalVector, toPosition);
+	return vec4(falloffSquared * falloffSquared * cornerDot,
+		falloffSquared * falloffSquared * diagonalVector - 8.0 * falloffSquared * falloff * cornerDot * toPosition);
+}
+// Returns the Simplex noise value in x and its partial derivatives in yzw
+vec4 SimplexNoiseWithGradient(const vec3 position)
+{
+	ivec3 location = ivec3(floor(position + (position.x + position.y + position.z) * SKEW_FACTOR));
+	vec3 toPosition = position - (vec3(location) - float(location.x + location.y + location.z) * UNSKEW_FACTOR);
+
+	// The amount of dimensions that are stepped along before each dimension, when stepping
+	// along the dimensions in order of decreasing "toPosition"
+	ivec3 ranks = ivec3(0);
+	ranks += toPosition.x < toPosition.y ? ivec3(1, 0, 0) : ivec3(0, 1, 0);
+	ranks += toPosition.x < toPosition.z ? ivec3(1, 0, 0) : ivec3(0, 0, 1);
+	ranks += toPosition.y < toPosition.z ? ivec3(0, 1, 0) : ivec3(0, 0, 1);
+	ivec3 offset1 = ivec3(lessThan(ranks, ivec3(1)));
+	ivec3 offset2 = ivec3(lessThan(ranks, ivec3(2)));
+
+	vec4 simplexValue =
+		GetSimplexCornerValue(location, toPosition) +
+		GetSimplexCornerValue(location + offset1, toPosition - vec3(offset1) + UNSKEW_FACTOR) +
+		GetSimplexCornerValue(location + offset2, toPosition - vec3(offset2) + 2.0 * UNSKEW_FACTOR) +
+		GetSimplexCornerValue(location + 1, toPosition - 1.0 + 3.0 * UNSKEW_FACTOR);
+	return simplexValue * SIMPLEX_SCALE * 0.5 + vec4(0.5, 0.0, 0.0, 0.0);
+}
+float SimplexNoise(const vec3 position)
+{
+	// The unused gradient gets optimized away
+	return SimplexNoiseWithGradient(position).x;
+}
+// End of Simplex noise
+
+// Noise that was baked on the CPU, which only needs a single filtered fetch. It stores
+// the value in r and the derivatives along x and z in g and b. It is the Perlin noise with
+// the permutation table in the plane y = 0, so it ignores the Simplex noise and the integer hash.
+layout(binding = 3) uniform sampler2D bakedNoise;
+layout(location = 15) uniform bool useBakedNoise;
+// Needs to match "Water::BAKED_NOISE_PERIOD"
+const float BAKED_NOISE_PERIOD = 256.0;
+
 float GetWaterAltitude(const vec3 position)
 {
 	float perlinFrequency = waterFactors[0];
@@ -192,9 +278,21 @@ float GetWaterAltitude(const vec3 position)
 	float frequencySinX = waterFactors[3];
 	float frequencySinZ = waterFactors[4];
 	float sinAmplitude = waterFactors[5];
+	// Selects between the Perlin and the Simplex noise
+	bool useSimplexNoise = waterFactors[6] >= 0.5;
 
-
-	float perlin = PerlinNoise(vec3(position.x, 0.0, position.z) * perlinFrequency) * perlinAmplitude;
+	vec3 noisePosition = vec3(position.x, 0.0, position.z) * perlinFrequency;
+	float noiseValue;
+	if (useBakedNoise)
+	{
+		// There are no derivatives to select a mipmap level with in this stage
+		noiseValue = textureLod(bakedNoise, noisePosition.xz / BAKED_NOISE_PERIOD, 0.0).r;
+	}
+	else
+	{
+		noiseValue = useSimplexNoise ? SimplexNoise(noisePosition) : PerlinNoise(noisePosition);
+	}
+	float perlin = noiseValue * perlinAmplitude;
 
 	float sinX = sin((position.x + perlin - time * timeFactor) * frequencySinX) * sinAmplitude;
 
@@ -235,8 +333,8 @@ void main()
 #version 450 core
 
 layout(location = 0) uniform vec3 cameraPosition;
-layout(location = 5) uniform float[8] waterFactors;
-layout(location = 13) uniform float time;
+layout(location = 5) uniform float[9] waterFactors;
+layout(location = 14) uniform float time;
 
 layout(binding = 1) uniform sampler2D diffuseMap;
 layout(binding = 2) uniform sampler2D normalMap;
@@ -249,55 +347,71 @@ float Smoothstep(float t)
 {
 	return t * t * t * (10.0 + t * (6.0 * t - 15.0));
 }
+// Needs to match "noise::IntegerHash::GetSeed" on the CPU
+layout(location = 16) uniform uint integerHashSeed;
+
 int AccessPermutationTable(int index)
 {
 	return int(texelFetch(permutationTable, index, 0).r);
 }
+// The same as "noise::MixBits" on the CPU
+uint MixBits(uint value)
+{
+	value ^= value >> 16;
+	value *= 0x7FEB352Du;
+	value ^= value >> 15;
+	value *= 0x846CA68Bu;
+	value ^= value >> 16;
+	return value;
+}
+// The same hash as "noise::IntegerHash" on the CPU. Only uses arithmetic, so unlike the
+// permutation table, it does not wait for three dependent texel fetches.
+uint GetIntegerHash(const ivec3 location)
+{
+	return MixBits(integerHashSeed ^ (uint(location.x) * 0x8DA6B343u) ^ (uint(location.y) * 0xD8163841u) ^ (uint(location.z) * 0xCB1AB31Fu));
+}
 uint GetRandomIndex(const ivec3 location)
 {
+	// Selects between the integer hash and the permutation table
+	bool useIntegerHash = waterFactors[7] >= 0.5;
+	if (useIntegerHash)
+	{
+		return GetIntegerHash(location) & uint(N_RANDOM_VALUES - 1);
+	}
 	return AccessPermutationTable(AccessPermutationTable(AccessPermutationTable(location.x) + location.y) + location.z);
 }
-float GetRandomPerlinValue(const uint index, const vec3 toPosition)
+// The same as "GetRandomIndex<2>" of the hash policies on the CPU
+uint GetRandomIndex(const ivec2 location)
+{
+	bool useIntegerHash = waterFactors[7] >= 0.5;
+	if (useIntegerHash)
+	{
+		return MixBits(integerHashSeed ^ (uint(location.x) * 0x8DA6B343u) ^ (uint(location.y) * 0xD8163841u)) & uint(N_RANDOM_VALUES - 1);
+	}
+	return AccessPermutationTable(AccessPermutationTable(location.x) + location.y);
+}
+float SmoothstepDerivative(float t)
 {
-	switch (index & 15)
+	return 30.0 * t * t * (t * (t - 2.0) + 1.0);
+}
+// The same diagonal vectors, in the same order, as "noise::CreateDiagonalVectors<3>" on the CPU, which
+// "PerlinNoise<3>" and "SimplexNoise<3>" pick from with the random index modulo 12
+vec3 GetDiagonalVector(const uint index)
+{
+	uint diagonalIndex = index % 12u;
+	vec2 signs = vec2((diagonalIndex & 1u) != 0u ? -1.0 : 1.0, (diagonalIndex & 2u) != 0u ? -1.0 : 1.0);
+	switch (diagonalIndex / 4u)
 	{
-	case 0:
-		return toPosition.x + toPosition.y;
-	case 1:
-		return toPosition.x - toPosition.y;
-	case 2:
-		return -toPosition.x + toPosition.y;
-	case 3:
-		return -toPosition.x - toPosition.y;
-	case 4:
-		return toPosition.y + toPosition.z;
-	case 5:
-		return toPosition.y - toPosition.z;
-	case 6:
-		return -toPosition.y + toPosition.z;
-	case 7:
-		return -toPosition.y - toPosition.z;
-	case 8:
-		return toPosition.x + toPosition.z;
-	case 9:
-		return toPosition.x - toPosition.z;
-	case 10:
-		return -toPosition.x + toPosition.z;
-	case 11:
-		return -toPosition.x - toPosition.z;
-	case 12:
-		return toPosition.x + toPosition.z;
-	case 13:
-		return toPosition.x - toPosition.z;
-	case 14:
-		return -toPosition.x + toPosition.z;
-	case 15:
-		return -toPosition.x - toPosition.z;
+	case 0u:
+		return vec3(0.0, signs.x, signs.y);
+	case 1u:
+		return vec3(signs.x, 0.0, signs.y);
 	default:
-		return -1.0;
+		return vec3(signs.x, signs.y, 0.0);
 	}
 }
-float PerlinNoise(const vec3 position)
+// Returns the Perlin noise value in x and its partial derivatives in yzw
+vec4 PerlinNoiseWithGradient(const vec3 position)
 {
 	int fx = int(floor(position.x));
 	int fy = int(floor(position.y));
@@ -319,28 +433,143 @@ float PerlinNoise(const vec3 position)
 	float sy = Smoothstep(ty);
 	float sz = Smoothstep(tz);
 
-	float c000 = GetRandomPerlinValue(GetRandomIndex(ivec3(x0, y0, z0)), vec3(tx, ty, tz));
-	float c100 = GetRandomPerlinValue(GetRandomIndex(ivec3(x1, y0, z0)), vec3(tx - 1, ty, tz));
-
-	float c001 = GetRandomPerlinValue(GetRandomIndex(ivec3(x0, y0, z1)), vec3(tx, ty, tz - 1));
-	float c101 = GetRandomPerlinValue(GetRandomIndex(ivec3(x1, y0, z1)), vec3(tx - 1, ty, tz - 1));
-
-	float c010 = GetRandomPerlinValue(GetRandomIndex(ivec3(x0, y1, z0)), vec3(tx, ty - 1, tz));
-	float c110 = GetRandomPerlinValue(GetRandomIndex(ivec3(x1, y1, z0)), vec3(tx - 1, ty - 1, tz));
-
-	float c011 = GetRandomPerlinValue(GetRandomIndex(ivec3(x0, y1, z1)), vec3(tx, ty - 1, tz - 1));
-	float c111 = GetRandomPerlinValue(GetRandomIndex(ivec3(x1, y1, z1)), vec3(tx - 1, ty - 1, tz - 1));
-
-	float perlinValue = mix(
-		mix(mix(c000, c100, sx), mix(c010, c110, sx), sy),
-		mix(mix(c001, c101, sx), mix(c011, c111, sx), sy),
+	vec3 g000 = GetDiagonalVector(GetRandomIndex(ivec3(x0, y0, z0)));
+	vec3 g100 = GetDiagonalVector(GetRandomIndex(ivec3(x1, y0, z0)));
+	vec3 g001 = GetDiagonalVector(GetRandomIndex(ivec3(x0, y0, z1)));
+	vec3 g101 = GetDiagonalVector(GetRandomIndex(ivec3(x1, y0, z1)));
+	vec3 g010 = GetDiagonalVector(GetRandomIndex(ivec3(x0, y1, z0)));
+	vec3 g110 = GetDiagonalVector(GetRandomIndex(ivec3(x1, y1, z0)));
+	vec3 g011 = GetDiagonalVector(GetRandomIndex(ivec3(x0, y1, z1)));
+	vec3 g111 = GetDiagonalVector(GetRandomIndex(ivec3(x1, y1, z1)));
+
+	float c000 = dot(g000, vec3(tx, ty, tz));
+	float c100 = dot(g100, vec3(tx - 1, ty, tz));
+	float c001 = dot(g001, vec3(tx, ty, tz - 1));
+	float c101 = dot(g101, vec3(tx - 1, ty, tz - 1));
+	float c010 = dot(g010, vec3(tx, ty - 1, tz));
+	float c110 = dot(g110, vec3(tx - 1, ty - 1, tz));
+	float c011 = dot(g011, vec3(tx, ty - 1, tz - 1));
+	float c111 = dot(g111, vec3(tx - 1, ty - 1, tz - 1));
+
+	float c00 = mix(c000, c100, sx);
+	float c10 = mix(c010, c110, sx);
+	float c01 = mix(c001, c101, sx);
+	float c11 = mix(c011, c111, sx);
+	float c0 = mix(c00, c10, sy);
+	float c1 = mix(c01, c11, sy);
+	float perlinValue = mix(c0, c1, sz);
+
+	// The corner values are dot products with the gradients, so the gradients get interpolated in
+	// the same way. The interpolation amounts also change along their own dimension.
+	vec3 gradient = mix(
+		mix(mix(g000, g100, sx), mix(g010, g110, sx), sy),
+		mix(mix(g001, g101, sx), mix(g011, g111, sx), sy),
 		sz
 	);
-	return (perlinValue + 1.0) / 2.0;
+	gradient += vec3(SmoothstepDerivative(tx), SmoothstepDerivative(ty), SmoothstepDerivative(tz)) * vec3(
+		mix(mix(c100 - c000, c110 - c010, sy), mix(c101 - c001, c111 - c011, sy), sz),
+		mix(c10 - c00, c11 - c01, sz),
+		c1 - c0
+	);
+	return vec4(perlinValue + 1.0, gradient) / 2.0;
+}
+float PerlinNoise(const vec3 position)
+{
+	// The unused gradient gets optimized away
+	return PerlinNoiseWithGradient(position).x;
 }
 // End of Perlin noise
 
-float GetWaterAltitude(const vec3 position)
+// Simplex noise, which gives the same values as "SimplexNoise<3>" on the CPU. Uses the
+// permutation table of the Perlin noise, but only evaluates 4 corners instead of 8.
+const float SKEW_FACTOR = 1.0 / 3.0;
+const float UNSKEW_FACTOR = 1.0 / 6.0;
+const float SIMPLEX_RADIUS_SQUARED = 0.5;
+const float SIMPLEX_SCALE = 76.0;
+
+// Returns the contribution of the corner in x and its partial derivatives in yzw
+vec4 GetSimplexCornerValue(const ivec3 location, const vec3 toPosition)
+{
+	vec3 diagonalVector = GetDiagonalVector(GetRandomIndex(location & (N_RANDOM_VALUES - 1)));
+	float falloff = max(SIMPLEX_RADIUS_SQUARED - dot(toPosition, toPosition), 0.0);
+	float falloffSquared = falloff * falloff;
+	float cornerDot = dot(diagonalVector, toPosition);
+	return vec4(falloffSquared * falloffSquared * cornerDot,
+		falloffSquared * falloffSquared * diagonalVector - 8.0 * falloffSquared * falloff * cornerDot * toPosition);
+}
+// Returns the Simplex noise value in x and its partial derivatives in yzw
+vec4 SimplexNoiseWithGradient(const vec3 position)
+{
+	ivec3 location = ivec3(floor(position + (position.x + position.y + position.z) * SKEW_FACTOR));
+	vec3 toPosition = position - (vec3(location) - float(location.x + location.y + location.z) * UNSKEW_FACTOR);
+
+	// The amount of dimensions that are stepped along before each dimension, when stepping
+	// along the dimensions in order of decreasing "toPosition"
+	ivec3 ranks = ivec3(0);
+	ranks += toPosition.x < toPosition.y ? ivec3(1, 0, 0) : ivec3(0, 1, 0);
+	ranks += toPosition.x < toPosition.z ? ivec3(1, 0, 0) : ivec3(0, 0, 1);
+	ranks += toPosition.y < toPosition.z ? ivec3(0, 1, 0) : ivec3(0, 0, 1);
+	ivec3 offset1 = ivec3(lessThan(ranks, ivec3(1)));
+	ivec3 offset2 = ivec3(lessThan(ranks, ivec3(2)));
+
+	vec4 simplexValue =
+		GetSimplexCornerValue(location, toPosition) +
+		GetSimplexCornerValue(location + offset1, toPosition - vec3(offset1) + UNSKEW_FACTOR) +
+		GetSimplexCornerValue(location + offset2, toPosition - vec3(offset2) + 2.0 * UNSKEW_FACTOR) +
+		GetSimplexCornerValue(location + 1, toPosition - 1.0 + 3.0 * UNSKEW_FACTOR);
+	return simplexValue * SIMPLEX_SCALE * 0.5 + vec4(0.5, 0.0, 0.0, 0.0);
+}
+float SimplexNoise(const vec3 position)
+{
+	// The unused gradient gets optimized away
+	return SimplexNoiseWithGradient(position).x;
+}
+// End of Simplex noise
+
+// Worley noise
+// A packed coordinate "q" of a feature point lies at "q * FEATURE_POINT_SCALE + FEATURE_POINT_BASE"
+// within its cell, which matches "WorleyNoise" on the CPU with a jitter of 1
+const float FEATURE_POINT_SCALE = 1.0 / 256.0;
+const float FEATURE_POINT_BASE = 0.5 - 127.5 / 256.0;
+
+// The same as "WorleyNoise<2>" on the CPU with the Euclidean metric. Returns F1 in x and F2 in y.
+vec2 WorleyNoise(const vec2 position)
+{
+	vec2 flooredPosition = floor(position);
+	ivec2 location = ivec2(flooredPosition);
+	vec2 fraction = position - flooredPosition;
+
+	// The distances are compared squared, which saves a square root per cell
+	vec2 distances = vec2(3.402823466e38);
+	for (int y = -1; y <= 1; ++y)
+	{
+		for (int x = -1; x <= 1; ++x)
+		{
+			ivec2 offset = ivec2(x, y);
+			uint featurePoint = MixBits(GetRandomIndex((location + offset) & (N_RANDOM_VALUES - 1)));
+			vec2 packedCoordinates = vec2(featurePoint & 255u, (featurePoint >> 8) & 255u);
+			vec2 delta = packedCoordinates * FEATURE_POINT_SCALE + (vec2(offset) + FEATURE_POINT_BASE) - fraction;
+
+			float squaredDistance = dot(delta, delta);
+			distances.y = min(distances.y, max(distances.x, squaredDistance));
+			distances.x = min(distances.x, squaredDistance);
+		}
+	}
+	return sqrt(distances);
+}
+// End of Worley noise
+
+// Noise that was baked on the CPU, which only needs a single filtered fetch. It stores
+// the value in r and the derivatives along x and z in g and b. It is the Perlin noise with
+// the permutation table in the plane y = 0, so it ignores the Simplex noise and the integer hash.
+layout(binding = 3) uniform sampler2D bakedNoise;
+layout(location = 15) uniform bool useBakedNoise;
+// Needs to match "Water::BAKED_NOISE_PERIOD"
+const float BAKED_NOISE_PERIOD = 256.0;
+
+// Also outputs the normal of the water surface at the position, which is calculated
+// from the analytic derivatives of the noise, instead of from extra altitude samples
+float GetWaterAltitude(const vec3 position, out vec3 normal)
 {
 	float perlinFrequency = waterFactors[0];
 	float perlinAmplitude = waterFactors[1];
@@ -348,20 +577,65 @@ float GetWaterAltitude(const vec3 position)
 	float frequencySinX = waterFactors[3];
 	float frequencySinZ = waterFactors[4];
 	float sinAmplitude = waterFactors[5];
+	// Selects between the Perlin and the Simplex noise
+	bool useSimplexNoise = waterFactors[6] >= 0.5;
 
+	vec3 noisePosition = vec3(position.x, 0.0, position.z) * perlinFrequency;
+	vec4 noiseWithGradient;
+	if (useBakedNoise)
+	{
+		vec3 bakedNoiseWithGradient = texture(bakedNoise, noisePosition.xz / BAKED_NOISE_PERIOD).rgb;
+		noiseWithGradient = vec4(bakedNoiseWithGradient.r, bakedNoiseWithGradient.g, 0.0, bakedNoiseWithGradient.b);
+	}
+	else
+	{
+		noiseWithGradient = useSimplexNoise ? SimplexNoiseWithGradient(noisePosition) : PerlinNoiseWithGradient(noisePosition);
+	}
+	float perlin = noiseWithGradient.x * perlinAmplitude;
+	// The derivatives of "perlin" along x and z
+	vec2 perlinDerivatives = noiseWithGradient.yw * perlinFrequency * perlinAmplitude;
 
-	float perlin = PerlinNoise(vec3(position.x, 0.0, position.z) * perlinFrequency) * perlinAmplitude;
+	float angleX = (position.x + perlin - time * timeFactor) * frequencySinX;
+	float sinX = sin(angleX) * sinAmplitude;
 
-	float sinX = sin((position.x + perlin - time * timeFactor) * frequencySinX) * sinAmplitude;
+	float angleZ = (position.z + perlin) * frequencySinZ;
+	float sinZ = sin(angleZ) * sinAmplitude;
 
-	float sinZ = sin((position.z + perlin) * frequencySinZ) * sinAmplitude;
+	// The derivatives of the altitude along x and z
+	vec2 derivatives =
+		cos(angleX) * frequencySinX * sinAmplitude * vec2(1.0 + perlinDerivatives.x, perlinDerivatives.y) +
+		cos(angleZ) * frequencySinZ * sinAmplitude * vec2(perlinDerivatives.x, 1.0 + perlinDerivatives.y);
+	normal = normalize(vec3(-derivatives.x, 1.0, -derivatives.y));
 
 	return sinX + sinZ;
 }
 
+const float FOAM_FREQUENCY = 0.5;
+// How far from the edges of the Worley cells the foam fades out
+const float FOAM_EDGE_WIDTH = 0.08;
+
+// Foam along the edges of the Worley cells, which only gathers on the crests of the waves and
+// drifts along with them. Returns how much of the colour should be replaced with foam.
+float GetFoam(const vec3 position, const float altitude)
+{
+	float timeFactor = waterFactors[2];
+	float sinAmplitude = waterFactors[5];
+	float foamAmount = waterFactors[8];
+
+	// The Worley noise evaluates 9 cells per fragment, so it is skipped when there is no foam
+	if (foamAmount <= 0.0)
+	{
+		return 0.0;
+	}
+
+	vec2 distances = WorleyNoise((position.xz - vec2(time * timeFactor, 0.0)) * FOAM_FREQUENCY);
+	float edges = 1.0 - smoothstep(0.0, FOAM_EDGE_WIDTH, distances.y - distances.x);
+	// The altitude lies between -2 * sinAmplitude and 2 * sinAmplitude
+	float crests = smoothstep(0.5, 1.0, altitude / max(2.0 * sinAmplitude, 0.0001));
+	return edges * crests * foamAmount;
+}
 
 const vec3 TO_SUN = normalize(vec3(1.0, 5.0, 0.0));
-const float DELTA = 0.0001;
 
 in TE_OUT
 {
@@ -374,14 +648,8 @@ out vec4 colour;
 void main()
 {
 	// Calculate normal
-	vec3 deltaX = vec3(fsIn.position.x + DELTA, 0.0, fsIn.position.z);
-	deltaX.y = GetWaterAltitude(deltaX);
-
-	vec3 deltaZ = vec3(fsIn.position.x, 0.0, fsIn.position.z - DELTA);
-	deltaZ.y = GetWaterAltitude(deltaZ);
-
-	vec3 normal = cross(deltaX, deltaZ);
-	normal = normalize(normal);
+	vec3 normal;
+	float altitude = GetWaterAltitude(fsIn.position, normal);
 
 	const vec3 forward = vec3(0.0, 0.0, 1.0);
 	const vec3 tangent = normalize(cross(forward, normal));
@@ -408,6 +676,7 @@ void main()
 
 	// We make the texture colour more blue
 	vec3 mixedColour = mix(textureColour, blue, 0.8);
+	mixedColour = mix(mixedColour, vec3(1.0), GetFoam(fsIn.position, altitude));
 
 	colour = vec4(mixedColour * brightness + specular, 0.98);
 }
\ No newline at end of file
@@ -14,7 +14,9 @@ layout(location = 5) uniform float scale;
 
 // Perlin noise
 layout(binding = 0) uniform usampler1D permutationTable;
-const int N_RANDOM_VALUES = 256;
+// The lattice wraps at the period of the baked noise, so that the procedural and the baked noise are
+// the same field. Needs to match "Cube::BAKED_NOISE_PERIOD".
+const int NOISE_PERIOD = 16;
 
 float Smoothstep(float t)
 {
@@ -28,59 +30,39 @@ uint GetRandomIndex(const ivec3 location)
 {
 	return AccessPermutationTable(AccessPermutationTable(AccessPermutationTable(location.x) + location.y) + location.z);
 }
-float GetRandomPerlinValue(const uint index, const vec3 toPosition)
+// The same diagonal vectors, in the same order, as "noise::CreateDiagonalVectors<3>" on the CPU, which
+// "PerlinNoise<3>" picks from with the random index modulo 12
+vec3 GetDiagonalVector(const uint index)
 {
-	switch (index & 15)
+	uint diagonalIndex = index % 12u;
+	vec2 signs = vec2((diagonalIndex & 1u) != 0u ? -1.0 : 1.0, (diagonalIndex & 2u) != 0u ? -1.0 : 1.0);
+	switch (diagonalIndex / 4u)
 	{
-	case 0:
-		return toPosition.x + toPosition.y;
-	case 1:
-		return toPosition.x - toPosition.y;
-	case 2:
-		return -toPosition.x + toPosition.y;
-	case 3:
-		return -toPosition.x - toPosition.y;
-	case 4:
-		return toPosition.y + toPosition.z;
-	case 5:
-		return toPosition.y - toPosition.z;
-	case 6:
-		return -toPosition.y + toPosition.z;
-	case 7:
-		return -toPosition.y - toPosition.z;
-	case 8:
-		return toPosition.x + toPosition.z;
-	case 9:
-		return toPosition.x - toPosition.z;
-	case 10:
-		return -toPosition.x + toPosition.z;
-	case 11:
-		return -toPosition.x - toPosition.z;
-	case 12:
-		return toPosition.x + toPosition.z;
-	case 13:
-		return toPosition.x - toPosition.z;
-	case 14:
-		return -toPosition.x + toPosition.z;
-	case 15:
-		return -toPosition.x - toPosition.z;
+	case 0u:
+		return vec3(0.0, signs.x, signs.y);
+	case 1u:
+		return vec3(signs.x, 0.0, signs.y);
 	default:
-		return -1.0;
+		return vec3(signs.x, signs.y, 0.0);
 	}
 }
+float GetRandomPerlinValue(const uint index, const vec3 toPosition)
+{
+	return dot(GetDiagonalVector(index), toPosition);
+}
 float PerlinNoise(const vec3 position)
 {
 	int fx = int(floor(position.x));
 	int fy = int(floor(position.y));
 	int fz = int(floor(position.z));
 
-	int x0 = int(fx & (N_RANDOM_VALUES - 1));
-	int y0 = int(fy & (N_RANDOM_VALUES - 1));
-	int z0 = int(fz & (N_RANDOM_VALUES - 1));
+	int x0 = int(fx & (NOISE_PERIOD - 1));
+	int y0 = int(fy & (NOISE_PERIOD - 1));
+	int z0 = int(fz & (NOISE_PERIOD - 1));
 
-	int x1 = (x0 + 1) & (N_RANDOM_VALUES - 1);
-	int y1 = (y0 + 1) & (N_RANDOM_VALUES - 1);
-	int z1 = (z0 + 1) & (N_RANDOM_VALUES - 1);
+	int x1 = (x0 + 1) & (NOISE_PERIOD - 1);
+	int y1 = (y0 + 1) & (NOISE_PERIOD - 1);
+	int z1 = (z0 + 1) & (NOISE_PERIOD - 1);
 
 	float tx = position.x - fx;
 	float ty = position.y - fy;
@@ -111,6 +93,21 @@ float PerlinNoise(const vec3 position)
 }
 // End of Perlin noise
 
+// Noise that was baked on the CPU, which is tileable and only needs a single filtered fetch
+layout(binding = 3) uniform sampler3D bakedNoise;
+layout(location = 6) uniform bool useBakedNoise;
+const float BAKED_NOISE_PERIOD = float(NOISE_PERIOD);
+
+float DistortionNoise(const vec3 position)
+{
+	if (useBakedNoise)
+	{
+		// There are no derivatives to select a mipmap level with in this stage
+		return textureLod(bakedNoise, position / BAKED_NOISE_PERIOD, 0.0).r;
+	}
+	return PerlinNoise(position);
+}
+
 out VS_OUT
 {
 	vec2 uv;
@@ -144,13 +141,13 @@ void main()
 	const float scaledTime = time * timeFactor;
 
 	vec3 distortedPosition = vertexPosition;
-	distortedPosition.x += (PerlinNoise(
+	distortedPosition.x += (DistortionNoise(
 		vec3(
 			distortedPosition.x * perlinPositionFrequency, 
 			distortedPosition.z * perlinPositionFrequency,
 			scaledTime)) * 2.0 - 1.0) * perlinAmplitude;
 
-	distortedPosition.z += (PerlinNoise(
+	distortedPosition.z += (DistortionNoise(
 		vec3(
 			distortedPosition.x * perlinPositionFrequency,
 			distortedPosition.z * perlinPositionFrequency,
@@ -167,7 +164,9 @@ layout(binding = 1) uniform sampler2D sampler;
 
 // Perlin noise
 layout(binding = 0) uniform usampler1D permutationTable;
-const int N_RANDOM_VALUES = 256;
+// The lattice wraps at the period of the baked noise, so that the procedural and the baked noise are
+// the same field. Needs to match "Cube::BAKED_NOISE_PERIOD".
+const int NOISE_PERIOD = 16;
 
 float Smoothstep(float t)
 {
@@ -181,59 +180,39 @@ uint GetRandomIndex(const ivec3 location)
 {
 	return AccessPermutationTable(AccessPermutationTable(AccessPermutationTable(location.x) + location.y) + location.z);
 }
-float GetRandomPerlinValue(const uint index, const vec3 toPosition)
+// The same diagonal vectors, in the same order, as "noise::CreateDiagonalVectors<3>" on the CPU, which
+// "PerlinNoise<3>" picks from with the random index modulo 12
+vec3 GetDiagonalVector(const uint index)
 {
-	switch (index & 15)
+	uint diagonalIndex = index % 12u;
+	vec2 signs = vec2((diagonalIndex & 1u) != 0u ? -1.0 : 1.0, (diagonalIndex & 2u) != 0u ? -1.0 : 1.0);
+	switch (diagonalIndex / 4u)
 	{
-	case 0:
-		return toPosition.x + toPosition.y;
-	case 1:
-		return toPosition.x - toPosition.y;
-	case 2:
-		return -toPosition.x + toPosition.y;
-	case 3:
-		return -toPosition.x - toPosition.y;
-	case 4:
-		return toPosition.y + toPosition.z;
-	case 5:
-		return toPosition.y - toPosition.z;
-	case 6:
-		return -toPosition.y + toPosition.z;
-	case 7:
-		return -toPosition.y - toPosition.z;
-	case 8:
-		return toPosition.x + toPosition.z;
-	case 9:
-		return toPosition.x - toPosition.z;
-	case 10:
-		return -toPosition.x + toPosition.z;
-	case 11:
-		return -toPosition.x - toPosition.z;
-	case 12:
-		return toPosition.x + toPosition.z;
-	case 13:
-		return toPosition.x - toPosition.z;
-	case 14:
-		return -toPosition.x + toPosition.z;
-	case 15:
-		return -toPosition.x - toPosition.z;
+	case 0u:
+		return vec3(0.0, signs.x, signs.y);
+	case 1u:
+		return vec3(signs.x, 0.0, signs.y);
 	default:
-		return -1.0;
+		return vec3(signs.x, signs.y, 0.0);
 	}
 }
+float GetRandomPerlinValue(const uint index, const vec3 toPosition)
+{
+	return dot(GetDiagonalVector(index), toPosition);
+}
 float PerlinNoise(const vec3 position)
 {
 	int fx = int(floor(position.x));
 	int fy = int(floor(position.y));
 	int fz = int(floor(position.z));
 
-	int x0 = int(fx & (N_RANDOM_VALUES - 1));
-	int y0 = int(fy & (N_RANDOM_VALUES - 1));
-	int z0 = int(fz & (N_RANDOM_VALUES - 1));
+	int x0 = int(fx & (NOISE_PERIOD - 1));
+	int y0 = int(fy & (NOISE_PERIOD - 1));
+	int z0 = int(fz & (NOISE_PERIOD - 1));
 
-	int x1 = (x0 + 1) & (N_RANDOM_VALUES - 1);
-	int y1 = (y0 + 1) & (N_RANDOM_VALUES - 1);
-	int z1 = (z0 + 1) & (N_RANDOM_VALUES - 1);
+	int x1 = (x0 + 1) & (NOISE_PERIOD - 1);
+	int y1 = (y0 + 1) & (NOISE_PERIOD - 1);
+	int z1 = (z0 + 1) & (NOISE_PERIOD - 1);
 
 	float tx = position.x - fx;
 	float ty = position.y - fy;
@@ -264,6 +243,20 @@ float PerlinNoise(const vec3 position)
 }
 // End of Perlin noise
 
+// Noise that was baked on the CPU, which is tileable and only needs a single filtered fetch
+layout(binding = 3) uniform sampler3D bakedNoise;
+layout(location = 6) uniform bool useBakedNoise;
+const float BAKED_NOISE_PERIOD = float(NOISE_PERIOD);
+
+float DistortionNoise(const vec3 position)
+{
+	if (useBakedNoise)
+	{
+		return texture(bakedNoise, position / BAKED_NOISE_PERIOD).r;
+	}
+	return PerlinNoise(position);
+}
+
 in VS_OUT
 {
 	vec2 uv;
@@ -280,8 +273,8 @@ void main()
 	const float perlinUvFrequency = 10.0;
 	const float perlinAmplitude = 1.0 / 20.0;
 	const float timeFactor = 10.0 / 17.0;
-	const float perlinX = PerlinNoise(vec3(uv * perlinUvFrequency, time * timeFactor)) * perlinAmplitude;
-	const float perlinY = PerlinNoise(vec3(uv * perlinUvFrequency, time * timeFactor) + vec3(2.0, 2.0, 2.0)) * perlinAmplitude;
+	const float perlinX = DistortionNoise(vec3(uv * perlinUvFrequency, time * timeFactor)) * perlinAmplitude;
+	const float perlinY = DistortionNoise(vec3(uv * perlinUvFrequency, time * timeFactor) + vec3(2.0, 2.0, 2.0)) * perlinAmplitude;
 
 	uv.x += perlinX;
 	uv.y += perlinY;
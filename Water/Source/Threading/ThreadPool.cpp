@@ -0,0 +1,116 @@
+#include "ThreadPool.h"
+#include "../Benchmark/BenchmarkMacros.h"
+
+ThreadPool::ThreadPool(const unsigned int nThreads)
+{
+	const unsigned int threadCount = nThreads == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : nThreads;
+	for (unsigned int i = 1; i < threadCount; ++i)
+	{
+		mWorkers.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lockGuard(mMutex);
+		mShouldStop = true;
+	}
+	mJobStarted.notify_all();
+	for (std::thread& worker : mWorkers)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::ParallelFor(const size_t count, const std::function<void(size_t)>& function)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	std::lock_guard parallelForLockGuard(mParallelForMutex);
+	{
+		std::lock_guard lockGuard(mMutex);
+		mFunction = &function;
+		mCount = count;
+		mNextIndex = 0;
+		mBusyWorkers = mWorkers.size();
+		mException = nullptr;
+		++mJobGeneration;
+	}
+	mJobStarted.notify_all();
+
+	RunIterations();
+
+	// Every worker has to have left the job before the next one can be started, since
+	// "function" is only borrowed for the duration of this call
+	std::unique_lock lock(mMutex);
+	mJobFinished.wait(lock, [this]() { return mBusyWorkers == 0; });
+	mFunction = nullptr;
+
+	if (mException)
+	{
+		std::rethrow_exception(mException);
+	}
+}
+
+unsigned int ThreadPool::GetThreadCount() const
+{
+	return (unsigned int)mWorkers.size() + 1;
+}
+
+ThreadPool& ThreadPool::GetShared()
+{
+	static ThreadPool instance;
+	return instance;
+}
+
+void ThreadPool::WorkerLoop()
+{
+	NAME_THREAD("Thread pool worker");
+
+	unsigned long long finishedGeneration = 0;
+	while (true)
+	{
+		{
+			std::unique_lock lock(mMutex);
+			mJobStarted.wait(lock, [&]() { return mShouldStop || mJobGeneration != finishedGeneration; });
+			if (mShouldStop)
+			{
+				return;
+			}
+			finishedGeneration = mJobGeneration;
+		}
+
+		RunIterations();
+
+		std::lock_guard lockGuard(mMutex);
+		if (--mBusyWorkers == 0)
+		{
+			mJobFinished.notify_one();
+		}
+	}
+}
+
+void ThreadPool::RunIterations()
+{
+	for (size_t i = mNextIndex++; i < mCount; i = mNextIndex++)
+	{
+		try
+		{
+			(*mFunction)(i);
+		}
+		catch (...)
+		{
+			std::lock_guard lockGuard(mMutex);
+			if (!mException)
+			{
+				mException = std::current_exception();
+			}
+			// Stop handing out iterations
+			mNextIndex = mCount;
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+// A fixed set of worker threads that run the iterations of "ParallelFor". The calling thread
+// runs iterations as well, so a pool of N threads only starts N - 1 workers.
+class ThreadPool
+{
+public:
+	// Uses one thread per hardware thread, if "nThreads" is 0
+	explicit ThreadPool(unsigned int nThreads = 0);
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Calls "function(i)" for every i in [0, count) and returns once all of the calls have returned.
+	// The indices are handed out one at a time, so uneven iterations get balanced between the threads.
+	// Rethrows the first exception that an iteration throws, after which no new iterations are started.
+	// Calls from several threads are run one after another. "function" must not call "ParallelFor".
+	void ParallelFor(size_t count, const std::function<void(size_t)>& function);
+	unsigned int GetThreadCount() const;
+
+	// A pool with one thread per hardware thread, for everything that does not need a pool of its own
+	static ThreadPool& GetShared();
+private:
+	void WorkerLoop();
+	// Runs iterations of the current job until there are none left
+	void RunIterations();
+private:
+	std::vector<std::thread> mWorkers;
+
+	// Guards everything below, except for "mNextIndex"
+	std::mutex mMutex;
+	std::condition_variable mJobStarted;
+	std::condition_variable mJobFinished;
+	// Incremented for every job, which lets a worker tell a new job from the one it just finished
+	unsigned long long mJobGeneration = 0;
+	bool mShouldStop = false;
+
+	const std::function<void(size_t)>* mFunction = nullptr;
+	size_t mCount = 0;
+	std::atomic<size_t> mNextIndex = 0;
+	// The workers that have not yet finished the current job
+	size_t mBusyWorkers = 0;
+	std::exception_ptr mException;
+
+	// Makes calls from several threads run one after another
+	std::mutex mParallelForMutex;
+};
@@ -1,6 +1,36 @@
 #include "Water.h"
 #include "Rendering/GlMacro.h"
-#include "Noise/PermutationTable.h"
+#include "Noise/NoiseTableRegistry.h"
+#include "Noise/PerlinNoise.h"
+#include "Noise/NoiseBaker.h"
+#include "Benchmark/BenchmarkMacros.h"
+
+namespace
+{
+    // The shaders evaluate the 3D noise in the plane y = 0, so that slice of it is what gets baked
+    template<int N_RANDOM_VALUES>
+    class PerlinNoiseSlice
+    {
+    public:
+        PerlinNoiseSlice(const std::shared_ptr<const PermutationTable<N_RANDOM_VALUES>>& permutationTable)
+            :
+            mPerlinNoise(permutationTable)
+        {}
+
+        noise::ValueWithGradient<2> GetWithGradient(const BasicVector<float, 2>& position, int period) const
+        {
+            const noise::ValueWithGradient<3> valueWithGradient = mPerlinNoise.GetWithGradient({ position[0], 0.0f, position[1] }, period);
+
+            noise::ValueWithGradient<2> sliceValueWithGradient;
+            sliceValueWithGradient.value = valueWithGradient.value;
+            sliceValueWithGradient.gradient[0] = valueWithGradient.gradient[0];
+            sliceValueWithGradient.gradient[1] = valueWithGradient.gradient[2];
+            return sliceValueWithGradient;
+        }
+    private:
+        PerlinNoise<3, N_RANDOM_VALUES> mPerlinNoise;
+    };
+}
 
 Water::Water(const std::string& programName, const std::string& variableFilename,
     const std::string& texture, const std::string& normalMap)
@@ -8,17 +38,28 @@ Water::Water(const std::string& programName, const std::string& variableFilename
     mProgram(programName),
     mWaterFactors(variableFilename),
     mTexture(texture),
-    mNormalMap(normalMap)
+    mNormalMap(normalMap),
+    mPermutationTable(NoiseTableRegistry::GetPermutationTable<PERMUTATION_SIZE>()),
+    mBakedNoise(2, BAKED_NOISE_RESOLUTION, BakeNoise(mPermutationTable))
 {
     // One patch consists of 4 vertices
     GL(glPatchParameteri(GL_PATCH_VERTICES, 4));
 
-    auto permutationTable = std::make_shared<BasicPermutationTable<unsigned char, PERMUTATION_SIZE>>();
+    // The texture stores the indices as bytes
+    std::vector<unsigned char> permutationBytes(mPermutationTable->Size());
+    for (size_t i = 0; i < permutationBytes.size(); ++i)
+    {
+        permutationBytes[i] = (unsigned char)(*mPermutationTable)[i];
+    }
+
     // Pass in the permutation table as a one-dimensional texture
     GL(glCreateTextures(GL_TEXTURE_1D, 1, &mPermutationTexture));
-    GL(glTextureStorage1D(mPermutationTexture, 1, GL_R8UI, (GLsizei)permutationTable->Size()));
-    GL(glTextureSubImage1D(mPermutationTexture, 0, 0, (GLsizei)permutationTable->Size(), GL_RED_INTEGER, 
-        GL_UNSIGNED_BYTE, permutationTable->GetPointerToData()));
+    GL(glTextureStorage1D(mPermutationTexture, 1, GL_R8UI, (GLsizei)permutationBytes.size()));
+    GL(glTextureSubImage1D(mPermutationTexture, 0, 0, (GLsizei)permutationBytes.size(), GL_RED_INTEGER, 
+        GL_UNSIGNED_BYTE, permutationBytes.data()));
+    // Integer textures cannot be filtered, and are incomplete unless the filtering is nearest
+    GL(glTextureParameteri(mPermutationTexture, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    GL(glTextureParameteri(mPermutationTexture, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
 }
 
 Water::~Water()
@@ -34,6 +75,8 @@ void Water::Update(float deltaTime)
 
 void Water::Render(float time, const Camera& camera, const Matrix4& projectionMatrix)
 {
+    GPU_BENCHMARK("Water");
+
     mProgram.Bind();
 
     BindTextures();
@@ -41,12 +84,29 @@ void Water::Render(float time, const Camera& camera, const Matrix4& projectionMa
 
     // Disable the culling, so that the water can be seen from underneath
     GL(glDisable(GL_CULL_FACE));
+
+    BENCHMARK_COUNTER_ADD("Patches drawn", WIDTH * HEIGHT);
+    // Every tessellation evaluation shader invocation outputs one vertex
+    GPU_BENCHMARK_COUNTER("Tessellated vertices", GL_TESS_EVALUATION_SHADER_INVOCATIONS);
     // Render "PATCH_WIDTH * PATCH_HEIGHT" amount of patches, where each path
     // consists of 4 vertices
     GL(glDrawArraysInstanced(GL_PATCHES, 0, 4, WIDTH * HEIGHT));
     GL(glEnable(GL_CULL_FACE));
 }
 
+void Water::SetUseBakedNoise(bool useBakedNoise)
+{
+    mUseBakedNoise = useBakedNoise;
+}
+
+std::vector<float> Water::BakeNoise(const std::shared_ptr<const PermutationTable<PERMUTATION_SIZE>>& permutationTable)
+{
+    BENCHMARK;
+
+    const PerlinNoiseSlice<PERMUTATION_SIZE> perlinNoiseSlice(permutationTable);
+    return noise::BakeTileable<2>(perlinNoiseSlice, BAKED_NOISE_RESOLUTION, BAKED_NOISE_PERIOD);
+}
+
 bool Water::IsPointInside(const Vector3& point) const
 {
     // The lower left corner of the water is located at (0, 0, 0)
@@ -60,6 +120,7 @@ void Water::BindTextures() const
     GL(glBindTextureUnit(0, mPermutationTexture));
     mTexture.Bind(1);
     mNormalMap.Bind(2);
+    mBakedNoise.Bind(3);
 }
 
 void Water::BindUniforms(float time, const Camera& camera, const Matrix4& projectionMatrix)
@@ -81,5 +142,7 @@ void Water::BindUniforms(float time, const Camera& camera, const Matrix4& projec
             GL(glUniform1fv(5, (int)size, waterFactors));
         });
 
-    GL(glUniform1f(13, time));
+    GL(glUniform1f(14, time));
+    GL(glUniform1i(15, mUseBakedNoise));
+    GL(glUniform1ui(16, mIntegerHash.GetSeed()));
 }
\ No newline at end of file
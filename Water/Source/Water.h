@@ -4,6 +4,9 @@
 #include "Rendering/Camera.h"
 #include "Mathematics/Matrix/Matrix.h"
 #include "Rendering/Texture.h"
+#include "Rendering/NoiseTexture.h"
+#include "Noise/PermutationTable.h"
+#include "Noise/NoiseHash.h"
 
 class Water
 {
@@ -14,7 +17,14 @@ public:
 	void Update(float deltaTime);
 	void Render(float time, const Camera& camera, const Matrix4& projectionMatrix);
 	bool IsPointInside(const Vector3& point) const;
+	// Makes the shaders fetch the noise from "mBakedNoise", instead of evaluating it. The baked noise
+	// only covers the Perlin noise with the permutation table, so "sn" and "ih" do not affect it.
+	void SetUseBakedNoise(bool useBakedNoise);
 private:
+	// The size of the permutation table
+	static constexpr int PERMUTATION_SIZE = 256;
+
+	static std::vector<float> BakeNoise(const std::shared_ptr<const PermutationTable<PERMUTATION_SIZE>>& permutationTable);
 	void BindTextures() const;
 	void BindUniforms(float time, const Camera& camera, const Matrix4& projectionMatrix);
 private:
@@ -24,10 +34,21 @@ private:
 	DynamicVariableManager<float> mWaterFactors;
 	Texture mTexture;
 	Texture mNormalMap;
+	// Shared by the CPU noise and "mPermutationTexture", through "NoiseTableRegistry"
+	std::shared_ptr<const PermutationTable<PERMUTATION_SIZE>> mPermutationTable;
 	// A texture that stores permutation table data, used inside the shaders 
 	GLuint mPermutationTexture = 0;
-	// The size of the permutation table
-	static constexpr int PERMUTATION_SIZE = 256;
+	// What the shaders hash with instead of the permutation table, when "ih" is set to 1
+	noise::IntegerHash<PERMUTATION_SIZE> mIntegerHash;
+	// The same Perlin noise that the shaders evaluate, baked on the CPU together with its gradient
+	NoiseTexture mBakedNoise;
+	bool mUseBakedNoise = false;
+	// 8 texels per unit of the noise
+	static constexpr int BAKED_NOISE_RESOLUTION = 2048;
+	// The amount of noise units that the baked noise spans before it repeats. The permutation table
+	// makes the evaluated noise repeat after the same amount of units, so the two are identical.
+	// Needs to match "BAKED_NOISE_PERIOD" inside of the shaders.
+	static constexpr int BAKED_NOISE_PERIOD = PERMUTATION_SIZE;
 
 	// The width of the water, in amount of patches
 	static constexpr unsigned int WIDTH = 50;